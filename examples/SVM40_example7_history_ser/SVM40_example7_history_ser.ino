@@ -0,0 +1,149 @@
+/*
+ *  Version 1.0 / October 2026 / paulvha
+ *
+ *   Example shows how to keep a history of samples and calculate a trend.
+ *
+ *   Every 12th sample is stored in the history. With 300 samples this
+ *   covers 1 hour and takes about 4200 bytes (fits on a MEGA2560, NOT on an UNO).
+ *   For an UNO lower HISTORY_SIZE to e.g. 60.
+ *
+ ********************************************************************************
+ *  HARDWARE CONNECTION
+ *  ..........................................................
+ *  Used Serial1.
+ *  SVM40 pin          ATMEGA
+ *  1 VCC --- RED    --- 5V
+ *  2 GND --- BLACK  --- GND
+ *  3 TX  --- GREEN  --- RX1
+ *  4 RX  --- YELLOW --- TX1
+ *  5 Select-  BLUE          (NOT CONNECTED)
+ *  6 nc      PURPLE         (NOT CONNECTED)
+ *
+ *  Open the serial monitor at 115200 baud
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  ===================================================================================
+ *  NO support, delivered as is, have fun, good luck !!
+ */
+
+/////////////////////////////////////////////////////////////
+// define serial communication channel to use for SVM40
+/////////////////////////////////////////////////////////////
+#define SVM40_COMMS Serial1
+
+/////////////////////////////////////////////////////////////
+// define history size and store every x-th sample
+/////////////////////////////////////////////////////////////
+#define HISTORY_SIZE 300
+#define DECIMATE     12
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request sending and receiving
+ * 2 : request sending and receiving + show protocol errors */
+ //////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+#include "svm40.h"
+#include "svm40_history.h"
+
+// create constructor
+SVM40 svm40;
+SVM40_History<HISTORY_SIZE> hist(DECIMATE);
+
+void setup() {
+
+  Serial.begin(115200);
+
+  serialTrigger((char *) "SVM40-Example7: history. press <enter> to start");
+
+  // set driver debug level
+  svm40.EnableDebugging(DEBUG);
+
+  SVM40_COMMS.begin(115200);
+
+  // Initialize SVM40 library
+  if (! svm40.begin(&SVM40_COMMS))
+     Errorloop((char *) "Could not set serial communication channel.");
+
+  // check for SVM40 connection
+  if (! svm40.probe()) Errorloop((char *) "could not probe / connect with SVM40.");
+  else Serial.println(F("Detected SVM40."));
+
+  // start measurement
+  if (svm40.start()) Serial.println(F("Measurement started"));
+  else Errorloop((char *) "Could NOT start measurement");
+}
+
+void loop() {
+  struct svm40_raw r;
+
+  if (svm40.GetRawValues(&r) == ERR_OK) {
+
+    // show trend each time a sample was stored
+    if (hist.Add(&r)) show_trend();
+  }
+
+  delay(1000);
+}
+
+/**
+ * @brief : display the VOC index and the change since the oldest sample
+ */
+void show_trend()
+{
+  struct svm40_sample oldest, newest;
+  struct svm40_values v;
+  uint32_t vocsum = 0;
+
+  for (svm40_sample s : hist) vocsum += s.raw.VOC_index / 10;
+
+  hist.Get(0, &oldest);
+  hist.Get(hist.Count() - 1, &newest);
+
+  // newest sample as full values
+  svm40.DecodeValues(&newest.raw, &v);
+
+  Serial.print(F("Samples: "));
+  Serial.print(hist.Count());
+  Serial.print(F("\tVOC index: "));
+  Serial.print(v.VOC_index);
+  Serial.print(F("\tVOC average: "));
+  Serial.print(vocsum / hist.Count());
+  Serial.print(F("\tTemperature: "));
+  Serial.print(v.temperature);
+  Serial.print(F("\tover (seconds): "));
+  Serial.println((newest.time - oldest.time) / 1000);
+}
+
+/**
+ *  @brief : continued loop after fatal error
+ *  @param mess : message to display
+ */
+void Errorloop(char *mess)
+{
+  Serial.println(mess);
+  Serial.println(F("Program on hold"));
+  for(;;) delay(100000);
+}
+
+/**
+ * serialTrigger prints repeated message, then waits for enter
+ * to come in from the serial port.
+ */
+void serialTrigger(char *mess)
+{
+  Serial.println();
+
+  while (!Serial.available()) {
+    Serial.println(mess);
+    delay(2000);
+  }
+
+  while (Serial.available())
+    Serial.read();
+}
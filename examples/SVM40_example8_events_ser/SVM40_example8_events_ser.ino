@@ -0,0 +1,137 @@
+/*
+ *  Version 1.0 / October 2026 / paulvha
+ *
+ *   Example shows how to raise alarms on VOC and climate conditions.
+ *
+ *   - VOC index above 250 for 30 seconds (cleared below 230)
+ *   - VOC index rising more than 100 points per minute
+ *   - risk of condensation : temperature less than 2 degrees above dew point
+ *
+ ********************************************************************************
+ *  HARDWARE CONNECTION
+ *  ..........................................................
+ *  Used Serial1.
+ *  SVM40 pin          ATMEGA
+ *  1 VCC --- RED    --- 5V
+ *  2 GND --- BLACK  --- GND
+ *  3 TX  --- GREEN  --- RX1
+ *  4 RX  --- YELLOW --- TX1
+ *  5 Select-  BLUE          (NOT CONNECTED)
+ *  6 nc      PURPLE         (NOT CONNECTED)
+ *
+ *  Open the serial monitor at 115200 baud
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  ===================================================================================
+ *  NO support, delivered as is, have fun, good luck !!
+ */
+
+/////////////////////////////////////////////////////////////
+// define serial communication channel to use for SVM40
+/////////////////////////////////////////////////////////////
+#define SVM40_COMMS Serial1
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request sending and receiving
+ * 2 : request sending and receiving + show protocol errors */
+ //////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+#include "svm40.h"
+#include "svm40_event.h"
+
+// create constructor
+SVM40 svm40;
+SVM40_Events events;
+
+void setup() {
+
+  Serial.begin(115200);
+
+  serialTrigger((char *) "SVM40-Example8: events. press <enter> to start");
+
+  // set driver debug level
+  svm40.EnableDebugging(DEBUG);
+
+  SVM40_COMMS.begin(115200);
+
+  // Initialize SVM40 library
+  if (! svm40.begin(&SVM40_COMMS))
+     Errorloop((char *) "Could not set serial communication channel.");
+
+  // check for SVM40 connection
+  if (! svm40.probe()) Errorloop((char *) "could not probe / connect with SVM40.");
+  else Serial.println(F("Detected SVM40."));
+
+  // set the rules
+  events.AddRule(SVM40_CH_VOC_INDEX, SVM40_RULE_ABOVE, 250, 20, 30000, voc_alarm);
+  events.AddRule(SVM40_CH_VOC_INDEX, SVM40_RULE_RISE, 100, 50, 0, voc_alarm);
+  events.AddRule(SVM40_CH_DEW_SPREAD, SVM40_RULE_BELOW, 2, 0.5, 0, dew_alarm);
+
+  // start measurement
+  if (svm40.start()) Serial.println(F("Measurement started"));
+  else Errorloop((char *) "Could NOT start measurement");
+}
+
+void loop() {
+  struct svm40_values v;
+
+  if (svm40.GetValues(&v) == ERR_OK) events.Process(&v);
+
+  delay(1000);
+}
+
+/**
+ * @brief : called on VOC rules
+ */
+void voc_alarm(uint8_t id, bool active, float value)
+{
+  Serial.print(F("VOC rule "));
+  Serial.print(id);
+  if (active) Serial.print(F(" ACTIVE, value "));
+  else Serial.print(F(" cleared, value "));
+  Serial.println(value);
+}
+
+/**
+ * @brief : called on condensation rule
+ */
+void dew_alarm(uint8_t id, bool active, float value)
+{
+  if (active) Serial.print(F("Risk of condensation, degrees above dew point "));
+  else Serial.print(F("Condensation risk cleared, degrees above dew point "));
+  Serial.println(value);
+}
+
+/**
+ *  @brief : continued loop after fatal error
+ *  @param mess : message to display
+ */
+void Errorloop(char *mess)
+{
+  Serial.println(mess);
+  Serial.println(F("Program on hold"));
+  for(;;) delay(100000);
+}
+
+/**
+ * serialTrigger prints repeated message, then waits for enter
+ * to come in from the serial port.
+ */
+void serialTrigger(char *mess)
+{
+  Serial.println();
+
+  while (!Serial.available()) {
+    Serial.println(mess);
+    delay(2000);
+  }
+
+  while (Serial.available())
+    Serial.read();
+}
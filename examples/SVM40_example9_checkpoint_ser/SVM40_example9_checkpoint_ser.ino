@@ -0,0 +1,146 @@
+/*
+ *  Version 1.0 / October 2026 / paulvha
+ *
+ *   Example shows how to keep the VOC algorithm state over a short power cut.
+ *
+ *   After 3 hours of measurement the VOC algorithm state is saved in EEPROM
+ *   every 5 minutes. At startup it is written back to the sensor if saved
+ *   less than 10 minutes ago, so the VOC index is useful right away instead
+ *   of after the learning phase.
+ *
+ *   The time MUST continue over a reset : replace GetClock() with a routine
+ *   that reads an RTC (or NTP on an ESP32). With millis() as in this example
+ *   a saved state is never restored after a reset.
+ *
+ ********************************************************************************
+ *  HARDWARE CONNECTION
+ *  ..........................................................
+ *  Used Serial1.
+ *  SVM40 pin          ATMEGA
+ *  1 VCC --- RED    --- 5V
+ *  2 GND --- BLACK  --- GND
+ *  3 TX  --- GREEN  --- RX1
+ *  4 RX  --- YELLOW --- TX1
+ *  5 Select-  BLUE          (NOT CONNECTED)
+ *  6 nc      PURPLE         (NOT CONNECTED)
+ *
+ *  Open the serial monitor at 115200 baud
+ *
+ *  ================================ Disclaimer ======================================
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  ===================================================================================
+ *  NO support, delivered as is, have fun, good luck !!
+ */
+
+/////////////////////////////////////////////////////////////
+// define serial communication channel to use for SVM40
+/////////////////////////////////////////////////////////////
+#define SVM40_COMMS Serial1
+
+/////////////////////////////////////////////////////////////
+/* define driver debug
+ * 0 : no messages
+ * 1 : request sending and receiving
+ * 2 : request sending and receiving + show protocol errors */
+ //////////////////////////////////////////////////////////////
+#define DEBUG 0
+
+#include "svm40.h"
+#include "svm40_checkpoint.h"
+#include "svm40_eeprom_storage.h"
+
+// create constructor
+SVM40 svm40;
+SVM40_Checkpoint checkpoint;
+SVM40_EepromStorage store(0, 200);      // EEPROM address 0 - 199 (10 slots)
+
+/**
+ * @brief : time in seconds (replace with an RTC)
+ */
+uint32_t GetClock()
+{
+  return(millis() / 1000);
+}
+
+void setup() {
+
+  Serial.begin(115200);
+
+  serialTrigger((char *) "SVM40-Example9: VOC state checkpoint. press <enter> to start");
+
+  // set driver debug level
+  svm40.EnableDebugging(DEBUG);
+
+  SVM40_COMMS.begin(115200);
+
+  // Initialize SVM40 library
+  if (! svm40.begin(&SVM40_COMMS))
+     Errorloop((char *) "Could not set serial communication channel.");
+
+  // check for SVM40 connection
+  if (! svm40.probe()) Errorloop((char *) "could not probe / connect with SVM40.");
+  else Serial.println(F("Detected SVM40."));
+
+#if defined ESP32 || defined ESP8266
+  EEPROM.begin(200);
+#endif
+
+  // restore the VOC algorithm state (if saved recently)
+  checkpoint.begin(&svm40, &store, GetClock);
+
+  switch(checkpoint.Restore()) {
+    case SVM40_CP_RESTORED: Serial.println(F("VOC state restored")); break;
+    case SVM40_CP_TOO_OLD:  Serial.println(F("VOC state saved too long ago")); break;
+    case SVM40_CP_ERROR:    Serial.println(F("Could not restore VOC state")); break;
+    default:                Serial.println(F("No VOC state saved")); break;
+  }
+
+  // start measurement
+  if (svm40.start()) Serial.println(F("Measurement started"));
+  else Errorloop((char *) "Could NOT start measurement");
+}
+
+void loop() {
+  struct svm40_values v;
+
+  if (svm40.GetValues(&v) == ERR_OK) {
+    Serial.print(F("VOC index "));
+    Serial.print(v.VOC_index);
+    Serial.print(F(", operating (minutes) "));
+    Serial.println(checkpoint.GetRunTime() / 60);
+  }
+
+  if (checkpoint.loop()) Serial.println(F("VOC state saved"));
+
+  delay(1000);
+}
+
+/**
+ *  @brief : continued loop after fatal error
+ *  @param mess : message to display
+ */
+void Errorloop(char *mess)
+{
+  Serial.println(mess);
+  Serial.println(F("Program on hold"));
+  for(;;) delay(100000);
+}
+
+/**
+ * serialTrigger prints repeated message, then waits for enter
+ * to come in from the serial port.
+ */
+void serialTrigger(char *mess)
+{
+  Serial.println();
+
+  while (!Serial.available()) {
+    Serial.println(mess);
+    delay(2000);
+  }
+
+  while (Serial.available())
+    Serial.read();
+}
@@ -0,0 +1,390 @@
+/**
+ * SVM40 driver microbenchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Measures the CPU time of the driver hot paths on Linux, to catch a
+ * performance regression between releases.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src bench.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o bench
+ *
+ * Usage :
+ *   bench [options]
+ *
+ *   -f text   only run benchmarks with text in the name
+ *   -t sec    minimum time per benchmark (default 0.5)
+ *   -j        output JSON
+ *   -c file   compare with the JSON output of an earlier run
+ *
+ *   bench -j > 2.2.json
+ *   ... change the driver ...
+ *   bench -c 2.2.json
+ *
+ * Reported per benchmark : ns per operation and heap allocations per
+ * operation (the driver should not allocate, so this must be zero).
+ *
+ * The *_sim benchmarks include the simulated sensor (extras/host) in the
+ * time, the delays of the driver are skipped (virtual clock).
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <new>
+#include "host.h"
+#include "svm40_sim.h"
+
+/*******************************************************************
+ *  ALLOCATION COUNTING
+ *******************************************************************/
+
+extern "C" void *__libc_malloc(size_t size);
+static unsigned long allocs = 0;
+
+extern "C" void *malloc(size_t size) {
+    allocs++;
+    return(__libc_malloc(size));
+}
+
+void *operator new(size_t size) {
+    void *p = malloc(size);
+    if (p == NULL) throw std::bad_alloc();
+    return(p);
+}
+
+void operator delete(void *p) noexcept {free(p);}
+void operator delete(void *p, size_t) noexcept {free(p);}
+
+/*******************************************************************
+ *  TEST STREAM
+ *******************************************************************/
+
+// returns the same bytes over and over
+class LoopStream : public Stream
+{
+  public:
+    void   Set(const uint8_t *d, uint8_t n) {memcpy(_d, d, n); _n = n; _p = 0;}
+    size_t write(uint8_t) {return(1);}
+    size_t write(const uint8_t *, size_t n) {return(n);}
+    int    available() {return(_n);}
+    int    read() {
+        uint8_t c = _d[_p];
+        if (++_p == _n) _p = 0;
+        return(c);
+    }
+    int    peek() {return(_d[_p]);}
+
+  private:
+    uint8_t _d[64];
+    uint8_t _n, _p;
+};
+
+/*******************************************************************
+ *  BENCHMARKS
+ *******************************************************************/
+
+static volatile uint32_t sink;
+
+class SVM40_Bench
+{
+  public:
+
+    static void fill_buffer(SVM40 &s, unsigned long n) {
+        while (n--) {
+            s.SHDLC_fill_buffer(SVM40_SHDLC_READ_BASE, SVM40_SHDLC_READ_RESULTS_INT_RAW);
+            sink += s._Send_BUF_Length;
+        }
+    }
+
+    // per byte
+    static void byte_stuff(SVM40 &s, unsigned long n) {
+        while (n--) sink += s.SHDLC_ByteStuff(n & 0xff, 0);
+    }
+
+    // per byte
+    static void byte_unstuff(SVM40 &s, unsigned long n) {
+        static const uint8_t b[4] = {0x31, 0x33, 0x5d, 0x5e};
+        while (n--) sink += s.SHDLC_ByteUnStuff(b[n & 3]);
+    }
+
+    // frame as for a read of all values
+    static void shdlc_crc(SVM40 &s, unsigned long n) {
+        uint8_t f[20];
+        for (uint8_t i = 0; i < sizeof(f); i++) f[i] = i * 37;
+        while (n--) {
+            f[5] = n;
+            sink += s.SHDLC_calc_CRC(f, 1, 17);
+        }
+    }
+
+    static void i2c_crc(SVM40 &s, unsigned long n) {
+        uint8_t d[2];
+        while (n--) {
+            d[0] = n; d[1] = n >> 8;
+            sink += s.I2C_calc_CRC(d);
+        }
+    }
+
+    // answer with all values (12 data bytes + 6 CRC)
+    static void i2c_read(SVM40 &s, unsigned long n) {
+        static LoopStream dev;
+        uint8_t a[18], i;
+
+        for (i = 0; i < 6; i++) {
+            a[i * 3] = 0x10 + i;
+            a[i * 3 + 1] = 0x80 + i;
+            a[i * 3 + 2] = s.I2C_calc_CRC(&a[i * 3]);
+        }
+        dev.Set(a, sizeof(a));
+        Wire.attach(&dev);
+        s.begin(&Wire);
+
+        while (n--) sink += s.I2C_ReadFromSVM(12, false);
+    }
+
+    // answer with all values, includes CRC check
+    static void shdlc_read(SVM40 &s, unsigned long n) {
+        static LoopStream dev;
+        uint8_t a[] = {0x7E, 0x00, 0x03, 0x00, 0x0C, 0x03, 0xE8, 0x11, 0x94, 0x0F, 0xA0,
+                       0x75, 0x30, 0x10, 0x68, 0x10, 0x68, 0x00, 0x7E};
+        uint8_t sum = 0, i;
+
+        // 0x11 would need byte stuffing
+        a[7] = 0x12;
+        for (i = 1; i < sizeof(a) - 2; i++) sum += a[i];
+        a[sizeof(a) - 2] = ~sum;
+
+        dev.Set(a, sizeof(a));
+        s.begin(&dev);
+
+        while (n--) sink += s.SHDLC_ReadFromSerial();
+    }
+
+    static void decode(SVM40 &s, unsigned long n, bool celsius) {
+        struct svm40_raw r = {1000, 4512, 4700, 30000, 4300, 4900};
+        struct svm40_values v;
+
+        s.SetTempCelsius(celsius);
+        while (n--) {
+            r.temperature = 4700 + (n & 0x3f);
+            s.DecodeValues(&r, &v);
+            sink += (uint32_t) v.dew_point;
+        }
+        s.SetTempCelsius(true);
+    }
+
+    static void decode_c(SVM40 &s, unsigned long n) {decode(s, n, true);}
+    static void decode_f(SVM40 &s, unsigned long n) {decode(s, n, false);}
+
+    static void get_values(SVM40 &s, unsigned long n, uint8_t mode) {
+        static SVM40_Sim sim_u(SVM40_SIM_UART), sim_i(SVM40_SIM_I2C);
+        struct svm40_values v;
+
+        if (mode == SVM40_SIM_I2C) {
+            Wire.attach(&sim_i);
+            s.begin(&Wire);
+        }
+        else
+            s.begin(&sim_u);
+
+        while (n--) {
+            s.GetValues(&v);
+            sink += v.VOC_index;
+        }
+    }
+
+    static void get_values_uart(SVM40 &s, unsigned long n) {get_values(s, n, SVM40_SIM_UART);}
+    static void get_values_i2c(SVM40 &s, unsigned long n) {get_values(s, n, SVM40_SIM_I2C);}
+};
+
+struct bench {
+    const char *name;
+    void (*func)(SVM40 &s, unsigned long n);
+};
+
+static struct bench benches[] = {
+    {"shdlc_fill_buffer",    SVM40_Bench::fill_buffer},
+    {"shdlc_byte_stuff",     SVM40_Bench::byte_stuff},
+    {"shdlc_byte_unstuff",   SVM40_Bench::byte_unstuff},
+    {"shdlc_crc",            SVM40_Bench::shdlc_crc},
+    {"shdlc_read_values",    SVM40_Bench::shdlc_read},
+    {"i2c_crc",              SVM40_Bench::i2c_crc},
+    {"i2c_read_values",      SVM40_Bench::i2c_read},
+    {"decode_values",        SVM40_Bench::decode_c},
+    {"decode_values_fahr",   SVM40_Bench::decode_f},
+    {"get_values_uart_sim",  SVM40_Bench::get_values_uart},
+    {"get_values_i2c_sim",   SVM40_Bench::get_values_i2c},
+};
+
+#define BENCH_COUNT (sizeof(benches) / sizeof(struct bench))
+
+/*******************************************************************
+ *  RUNNER
+ *******************************************************************/
+
+static double now_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+struct result {
+    unsigned long iter;
+    double        ns;               // per operation
+    double        allocs;           // per operation
+};
+
+/**
+ * @brief : run a benchmark for at least min seconds
+ */
+static void run(struct bench *b, double min, struct result *r) {
+    SVM40 s;
+    unsigned long n = 1;
+    unsigned long a;
+    double t;
+
+    // first run (warm up and initialize)
+    b->func(s, 1);
+
+    while (true) {
+        a = allocs;
+        t = now_s();
+        b->func(s, n);
+        t = now_s() - t;
+        a = allocs - a;
+
+        if (t >= min || n > 1000000000UL) break;
+
+        // aim at the minimum time
+        if (t < min / 100) n *= 100;
+        else n = (unsigned long) (n * min * 1.2 / t) + 1;
+    }
+
+    r->iter = n;
+    r->ns = t * 1e9 / n;
+    r->allocs = (double) a / n;
+}
+
+/**
+ * @brief : get ns_per_op of a benchmark from an earlier JSON output
+ *
+ * @return : value or -1 if not found
+ */
+static double earlier(const char *json, const char *name) {
+    char key[64];
+    const char *p;
+
+    snprintf(key, sizeof(key), "\"name\": \"%s\"", name);
+    if ((p = strstr(json, key)) == NULL) return(-1);
+    if ((p = strstr(p, "\"ns_per_op\":")) == NULL) return(-1);
+
+    return(atof(p + 12));
+}
+
+static char *load(const char *name) {
+    FILE *fp;
+    long len;
+    char *buf;
+
+    if ((fp = fopen(name, "rb")) == NULL) return(NULL);
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    buf = (char *) calloc(len + 1, 1);
+    if (buf && fread(buf, 1, len, fp) != (size_t) len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+    return(buf);
+}
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-f text] [-t sec] [-j] [-c file]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    struct result r;
+    const char *filter = NULL;
+    char *cmp = NULL;
+    double min = 0.5, old;
+    bool json = false, first = true;
+    unsigned i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:jc:")) != -1) {
+        switch(opt) {
+            case 'f': filter = optarg; break;
+            case 't': min = atof(optarg); break;
+            case 'j': json = true; break;
+            case 'c':
+                if ((cmp = load(optarg)) == NULL) {
+                    fprintf(stderr, "can not read %s\n", optarg);
+                    return(1);
+                }
+                break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (json) (printf)("{\n  \"driver\": \"%d.%d\",\n  \"benchmarks\": [", DRIVER_MAJOR, DRIVER_MINOR);
+    else (printf)("%-22s %12s %10s %12s%s\n", "benchmark", "iterations", "ns/op", "allocs/op",
+                  cmp ? "   earlier    change" : "");
+
+    for (i = 0; i < BENCH_COUNT; i++) {
+
+        if (filter && strstr(benches[i].name, filter) == NULL) continue;
+
+        run(&benches[i], min, &r);
+
+        if (json) {
+            (printf)("%s\n    {\"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f}",
+                     first ? "" : ",", benches[i].name, r.iter, r.ns, r.allocs);
+            first = false;
+            continue;
+        }
+
+        (printf)("%-22s %12lu %10.2f %12.3f", benches[i].name, r.iter, r.ns, r.allocs);
+
+        if (cmp) {
+            old = earlier(cmp, benches[i].name);
+            if (old > 0) (printf)(" %10.2f %+8.1f%%", old, (r.ns - old) * 100 / old);
+            else (printf)(" %10s", "-");
+        }
+
+        (printf)("\n");
+    }
+
+    if (json) (printf)("\n  ]\n}\n");
+
+    free(cmp);
+    return(0);
+}
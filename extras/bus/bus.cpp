@@ -0,0 +1,222 @@
+/**
+ * SVM40 shared I2C bus benchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * One simulated SVM40 (extras/host/svm40_sim.h) shares a Wire bus with
+ * other drivers, each running in its own thread. The SVM40 is read
+ * continuously, the other drivers hold the bus for a short transaction
+ * every period. All use SVM40_Bus (src/svm40_bus.h) and the result shows :
+ *
+ *   bus      : transactions, % of time the bus was held, longest hold and
+ *              the most drivers waiting at the same time
+ *   per driver : transactions, average and longest wait for the bus in uS
+ *   svm40    : samples, errors and mS per sample
+ *
+ * With -L the SVM40 holds the bus for the complete command, including the
+ * wait for the answer, to compare. The other drivers do not really use the
+ * Wire port (it is attached to the SVM40 simulator), they only hold the
+ * bus for the time set with -h. This runs in real time.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src bus.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o bus -lpthread
+ *
+ * Usage :
+ *   bus [options]
+ *
+ *   -k num    number of other drivers (default 3)
+ *   -h uS     bus time of a transaction of an other driver (default 500)
+ *   -p mS     period of the other drivers (default 10)
+ *   -d sec    duration in seconds (default 5)
+ *   -L        SVM40 holds the bus for the complete command
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_bus.h"
+
+struct client {
+    uint32_t  transactions;
+    uint32_t  errors;
+    uint64_t  wait_us;
+    uint32_t  wait_max_us;
+};
+
+static std::atomic<bool> stop(false);
+
+/**
+ * @brief : lock hook for the bus
+ */
+static void bus_lock(void *arg, bool lock) {
+    std::mutex *m = (std::mutex *) arg;
+    if (lock) m->lock();
+    else m->unlock();
+}
+
+/**
+ * @brief : sleep in uS
+ */
+static void hold(uint32_t us) {
+    struct timespec ts;
+
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000L;
+    nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief : an other driver on the bus
+ * @param bus    : shared bus
+ * @param hold_us: bus time of a transaction
+ * @param period : mS between transactions
+ * @param c      : to store result
+ */
+static void run_other(SVM40_Bus *bus, uint32_t hold_us, uint32_t period, struct client *c) {
+    uint32_t start, wait;
+
+    while (! stop) {
+        start = micros();
+        bus->Acquire();
+        wait = micros() - start;
+        hold(hold_us);
+        bus->Release();
+
+        c->transactions++;
+        c->wait_us += wait;
+        if (wait > c->wait_max_us) c->wait_max_us = wait;
+
+        delay(period);
+    }
+}
+
+/**
+ * @brief : read the SVM40
+ * @param svm   : driver
+ * @param bus   : shared bus
+ * @param whole : hold the bus for the complete command
+ * @param c     : to store result
+ */
+static void run_svm40(SVM40 *svm, SVM40_Bus *bus, bool whole, struct client *c) {
+    struct svm40_values v;
+    uint32_t start, wait;
+
+    while (! stop) {
+        start = micros();
+
+        if (whole) bus->Acquire();
+        if (svm->GetValues(&v) != ERR_OK) c->errors++;
+        if (whole) bus->Release();
+
+        wait = micros() - start;
+        c->transactions++;
+        c->wait_us += wait;
+        if (wait > c->wait_max_us) c->wait_max_us = wait;
+    }
+}
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-k num] [-h uS] [-p mS] [-d sec] [-L]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t k = 3, hold_us = 500, period = 10, duration = 5, i;
+    bool whole = false;
+    struct svm40_bus_stats s;
+    std::mutex m;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:h:p:d:L")) != -1) {
+        switch(opt) {
+            case 'k': k = atoi(optarg); break;
+            case 'h': hold_us = atoi(optarg); break;
+            case 'p': period = atoi(optarg); break;
+            case 'd': duration = atoi(optarg); break;
+            case 'L': whole = true; break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (duration == 0) usage(argv[0]);
+
+    host_realtime(true);
+
+    SVM40_Sim sim(SVM40_SIM_I2C);
+    TwoWire wire;
+    SVM40_Bus bus(&wire);
+    SVM40 svm;
+    struct client *c = new struct client[k + 1];
+    std::thread *th = new std::thread[k + 1];
+
+    memset(c, 0, (k + 1) * sizeof(struct client));
+
+    wire.attach(&sim);
+    bus.SetLock(bus_lock, &m);
+
+    // the SVM40 does not know the bus is shared with -L
+    if (whole) svm.begin(&wire);
+    else svm.begin(&bus);
+
+    bus.ClearStats();
+
+    th[0] = std::thread(run_svm40, &svm, &bus, whole, &c[0]);
+    for (i = 1; i <= k; i++) th[i] = std::thread(run_other, &bus, hold_us, period, &c[i]);
+
+    delay(duration * 1000);
+    stop = true;
+
+    for (i = 0; i <= k; i++) th[i].join();
+
+    bus.GetStats(&s);
+
+    (printf)("%u seconds, %u other driver(s), %u uS every %u mS, SVM40 holds bus for %s\n\n",
+             duration, k, hold_us, period, whole ? "complete command" : "write and read");
+
+    (printf)("bus : %u transactions, %.2f%% busy, longest hold %u uS, at most %u waiting\n\n",
+             s.transactions, s.elapsed_us ? (double) s.busy_us * 100 / s.elapsed_us : 0,
+             s.hold_max_us, s.queue_max > 0 ? s.queue_max - 1 : 0);
+
+    (printf)("%-8s %12s %12s %12s\n", "driver", "transactions", "wait avg uS", "wait max uS");
+    for (i = 1; i <= k; i++) {
+        (printf)("other%-3u %12u %12.0f %12u\n", i, c[i].transactions,
+                 c[i].transactions ? (double) c[i].wait_us / c[i].transactions : 0, c[i].wait_max_us);
+    }
+
+    (printf)("\nsvm40 : %u samples, %u errors, %.1f mS per sample\n", c[0].transactions, c[0].errors,
+             c[0].transactions ? (double) c[0].wait_us / c[0].transactions / 1000 : 0);
+
+    delete [] th;
+    delete [] c;
+    return(0);
+}
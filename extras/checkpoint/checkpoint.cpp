@@ -0,0 +1,147 @@
+/**
+ * SVM40 VOC state checkpoint round trip check on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Checks with the simulated sensor (extras/host/svm40_sim.h) on UART and
+ * I2C, with a VOC state holding the UART special bytes (0x7E, 0x7D, 0x11,
+ * 0x13), that a checkpoint (svm40_checkpoint.h) saved after 3 hours :
+ *
+ *   - is restored by Restore() after a restart of the MCU and the sensor
+ *   - is restored by GetValues() after a reboot of the sensor only
+ *
+ * The checkpoints are kept in /tmp/svm40_checkpoint.bin. Exit code 0 if
+ * all passed.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src checkpoint.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp ../../src/svm40_checkpoint.cpp -o checkpoint
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_checkpoint.h"
+#include "svm40_file_storage.h"
+
+#define CP_FILE "/tmp/svm40_checkpoint.bin"
+
+static const uint8_t state[8] = {0x7E, 0x7D, 0x11, 0x13, 0x01, 0x7E, 0x7D, 0x02};
+static int failed;
+
+// time that continues over a restart of the MCU
+static uint32_t clk() {
+    return(1000000000UL + millis() / 1000);
+}
+
+static void check(const char *name, bool ok) {
+    printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+    if (! ok) failed++;
+}
+
+static void connect(SVM40 *s, SVM40_Sim *sim, TwoWire *wire, uint8_t mode) {
+    if (mode == SVM40_SIM_I2C) {
+        wire->attach(sim);
+        s->begin(wire);
+    }
+    else
+        s->begin(sim);
+}
+
+static void run(uint8_t mode) {
+    const char *tr = mode == SVM40_SIM_UART ? "UART" : "I2C";
+    struct svm40_values v;
+    uint8_t got[8], ret;
+    char name[80];
+
+    remove(CP_FILE);
+
+    SVM40_Sim sim(mode);
+    TwoWire wire;
+
+    // measure for 4 hours with checkpoints
+    {
+        SVM40_FileStorage store(CP_FILE, 200);
+        SVM40_Checkpoint cp;
+        SVM40 s;
+
+        connect(&s, &sim, &wire, mode);
+        cp.begin(&s, &store, clk);
+        s.start();
+        s.SetVocState((uint8_t *) state);
+
+        for (int t = 0; t < 4 * 3600; t += 10) {
+            host_advance(10000);
+            cp.loop();
+        }
+
+        snprintf(name, sizeof(name), "%s checkpoint saved", tr);
+        check(name, cp.GetLatest(got) != 0 && memcmp(got, state, 8) == 0);
+    }
+
+    // restart of the MCU and the sensor
+    host_advance(60000);
+    sim.Reset();
+    {
+        SVM40_FileStorage store(CP_FILE, 200);
+        SVM40_Checkpoint cp;
+        SVM40 s;
+
+        connect(&s, &sim, &wire, mode);
+        cp.begin(&s, &store, clk);
+        s.start();
+
+        ret = cp.Restore();
+        s.GetVocState(got);
+        snprintf(name, sizeof(name), "%s Restore() after restart", tr);
+        check(name, ret == SVM40_CP_RESTORED && memcmp(got, state, 8) == 0);
+
+        // reboot of the sensor only
+        for (int t = 0; t < 300; t += 10) {
+            host_advance(10000);
+            cp.loop();
+        }
+
+        sim.Reset();
+        host_advance(5000);
+
+        ret = s.GetValues(&v);
+        s.GetVocState(got);
+        snprintf(name, sizeof(name), "%s GetValues() after reboot", tr);
+        check(name, ret == ERR_OK && s.GetReboots() == 1 && memcmp(got, state, 8) == 0);
+    }
+
+    remove(CP_FILE);
+}
+
+int main() {
+    run(SVM40_SIM_UART);
+    run(SVM40_SIM_I2C);
+
+    printf("\n%s\n", failed ? "FAILED" : "all passed");
+    return(failed ? 1 : 0);
+}
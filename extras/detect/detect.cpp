@@ -0,0 +1,125 @@
+/**
+ * SVM40 port auto-detection benchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * A carrier board with serial ports and Wire buses of which one has a
+ * simulated SVM40 (extras/host/svm40_sim.h), the other ports are silent.
+ * The time to find the sensor is measured with probe() on each port in
+ * turn and with SVM40_Detect (src/svm40_detect.h) on all ports at once.
+ * It uses the virtual clock (host.h), so it takes no real time.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src detect.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp ../../src/svm40_detect.cpp -o detect
+ *
+ * Usage :
+ *   detect [options]
+ *
+ *   -s num    number of serial ports (default 3)
+ *   -w num    number of Wire buses (default 2)
+ *   -p num    port with the sensor, serial first (default last)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_detect.h"
+
+// serial port without a sensor
+class Silent : public Stream
+{
+  public:
+    size_t write(uint8_t c) {(void) c; return(1);}
+    using  Print::write;
+    int    available() {return(0);}
+    int    read() {return(-1);}
+    int    peek() {return(-1);}
+};
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-s num] [-w num] [-p num]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    int ns = 3, nw = 2, at = -1, opt, i, found;
+    uint32_t st;
+
+    while ((opt = getopt(argc, argv, "s:w:p:")) != -1) {
+        switch(opt) {
+            case 's': ns = atoi(optarg); break;
+            case 'w': nw = atoi(optarg); break;
+            case 'p': at = atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (ns < 0 || nw < 0 || ns + nw == 0 || ns + nw > SVM40_DETECT_PORTS) usage(argv[0]);
+    if (at < 0 || at >= ns + nw) at = ns + nw - 1;
+
+    Silent silent;
+    SVM40_Sim sim(at < ns ? SVM40_SIM_UART : SVM40_SIM_I2C);
+    TwoWire *wire = new TwoWire[nw];
+    Stream **port = new Stream *[ns];
+
+    for (i = 0; i < ns; i++) port[i] = i == at ? (Stream *) &sim : (Stream *) &silent;
+    if (at >= ns) wire[at - ns].attach(&sim);
+
+    printf("%d serial, %d Wire, sensor on port %d (%s)\n", ns, nw, at, at < ns ? "serial" : "Wire");
+
+    // one port after the other
+    SVM40 svm;
+    st = millis();
+    found = -1;
+
+    for (i = 0; i < ns + nw && found < 0; i++) {
+        if (i < ns) svm.begin(port[i]);
+        else svm.begin(&wire[i - ns]);
+        if (svm.probe()) found = i;
+    }
+
+    printf("probe()       : port %2d in %6lu mS\n", found, (unsigned long) (millis() - st));
+
+    // all ports at once
+    SVM40_Detect det;
+    SVM40_version v;
+
+    for (i = 0; i < ns; i++) det.Add(port[i]);
+    for (i = 0; i < nw; i++) det.Add(&wire[i]);
+
+    found = det.Run(&svm);
+    det.GetVersion(&v);
+
+    printf("SVM40_Detect  : port %2d in %6lu mS, firmware %d.%d\n", found,
+           (unsigned long) det.GetTime(), v.major, v.minor);
+
+    delete [] wire;
+    delete [] port;
+    return(0);
+}
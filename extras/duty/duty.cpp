@@ -0,0 +1,116 @@
+/**
+ * SVM40 duty-cycled acquisition on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Runs SVM40_Scheduler (src/svm40_scheduler.h) with the simulated sensor
+ * (extras/host/svm40_sim.h) on I2C and the virtual clock, so hours of samples take
+ * a fraction of a second. The sleep routine is delay(), that advances the
+ * virtual clock. The time the program really runs is the active time.
+ *
+ * Shows for each sample decimation : samples read, errors, missed
+ * instants, active and sleep time, duty cycle and the estimated charge and
+ * average current.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src duty.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp ../../src/svm40_scheduler.cpp -o duty
+ *
+ * Usage :
+ *   duty [options]
+ *
+ *   -e num    read every num seconds, more can be given (default 1 10 60)
+ *   -h hours  duration (default 1)
+ *   -a mA     MCU active current (default 5)
+ *   -s uA     MCU sleep current (default 10)
+ *   -m mA     sensor current (default 0)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_scheduler.h"
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-e num]... [-h hours] [-a mA] [-s uA] [-m mA]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    uint16_t every[8] = {1, 10, 60};
+    int n = 0, opt, i;
+    float hours = 1;
+    struct svm40_power pw = {5, 10, 0};
+    struct svm40_energy e;
+    struct svm40_values v;
+    uint32_t end;
+
+    while ((opt = getopt(argc, argv, "e:h:a:s:m:")) != -1) {
+        switch(opt) {
+            case 'e': if (n < 8) every[n++] = atoi(optarg); break;
+            case 'h': hours = atof(optarg); break;
+            case 'a': pw.active_ma = atof(optarg); break;
+            case 's': pw.sleep_ua = atof(optarg); break;
+            case 'm': pw.sensor_ma = atof(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (n == 0) n = 3;
+    if (hours <= 0) usage(argv[0]);
+
+    printf("%.1f hours, MCU %.1f mA active / %.1f uA sleep, sensor %.1f mA\n\n",
+           hours, pw.active_ma, pw.sleep_ua, pw.sensor_ma);
+    printf("every  samples errors missed  active mS    sleep mS   duty %%   charge mAh  avg mA  VOC\n");
+
+    for (i = 0; i < n; i++) {
+
+        SVM40_Sim sim(SVM40_SIM_I2C);
+        TwoWire wire;
+        SVM40 svm;
+        SVM40_Scheduler sch;
+
+        wire.attach(&sim);
+        svm.begin(&wire);
+        sch.SetPower(&pw);
+        sch.begin(&svm, every[i]);
+
+        end = millis() + (uint32_t) (hours * 3600000);
+        v.VOC_index = 0;
+
+        while ((int32_t) (millis() - end) < 0) sch.loop(&v);
+
+        sch.GetEnergy(&e);
+
+        printf("%5u %8u %6u %6u %10u %11u %8.4f %11.4f %7.4f %4u\n", every[i], e.samples,
+               e.errors, e.missed, e.active_ms, e.sleep_ms, e.duty * 100, e.charge_mah,
+               e.avg_ma, v.VOC_index);
+    }
+
+    return(0);
+}
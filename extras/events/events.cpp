@@ -0,0 +1,105 @@
+/**
+ * SVM40 event rule check on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Checks the RISE / FALL rules of SVM40_Events (svm40_event.h) with
+ * samples at 1 Hz :
+ *
+ *   - a VOC index jitter of +/- 1 point does not trigger a 10/min rule
+ *   - a ramp of 30 points per minute does, with the rate
+ *   - the rule clears once the ramp stops, with the rate
+ *
+ * Exit code 0 if all passed.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src events.cpp ../host/host.cpp ../../src/svm40.cpp \
+ *       ../../src/svm40_bus.cpp ../../src/svm40_event.cpp -o events
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "svm40_event.h"
+
+static int   active, cleared;       // callbacks
+static float last;                  // value of the last callback
+static int   failed;
+
+static void cb(uint8_t id, bool act, float value) {
+    (void) id;
+    if (act) active++;
+    else cleared++;
+    last = value;
+}
+
+static void check(const char *name, bool ok) {
+    printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+    if (! ok) failed++;
+}
+
+static void run(svm40_rule_type type) {
+    const char *tr = type == SVM40_RULE_RISE ? "RISE" : "FALL";
+    int dir = type == SVM40_RULE_RISE ? 1 : -1;
+    struct svm40_values v;
+    SVM40_Events e;
+    char name[80];
+    uint32_t t = 0;
+    int i;
+
+    memset(&v, 0, sizeof(v));
+    active = cleared = 0;
+    e.AddRule(SVM40_CH_VOC_INDEX, type, 10, 5, 0, cb);
+
+    // jitter for 10 minutes
+    for (i = 0; i < 600; i++, t += 1000) {
+        v.VOC_index = 100 + (i & 1);
+        e.Process(&v, t);
+    }
+    snprintf(name, sizeof(name), "%s 10/min : jitter +/- 1", tr);
+    check(name, active == 0);
+
+    // 30 points per minute for 3 minutes
+    for (i = 0; i < 180; i++, t += 1000) {
+        v.VOC_index = 100 + dir * i / 2;
+        e.Process(&v, t);
+    }
+    snprintf(name, sizeof(name), "%s 10/min : ramp of 30/min", tr);
+    check(name, active == 1 && cleared == 0 && last >= 29 && last <= 31);
+
+    // steady
+    for (i = 0; i < 180; i++, t += 1000) e.Process(&v, t);
+    snprintf(name, sizeof(name), "%s 10/min : cleared after ramp", tr);
+    check(name, active == 1 && cleared == 1 && last <= 5);
+}
+
+int main() {
+    run(SVM40_RULE_RISE);
+    run(SVM40_RULE_FALL);
+
+    printf("\n%s\n", failed ? "FAILED" : "all passed");
+    return(failed ? 1 : 0);
+}
@@ -0,0 +1,177 @@
+/**
+ * SVM40 fault injection benchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Reads samples from the simulated sensor (extras/host/svm40_sim.h) with
+ * the fault injector (extras/host/svm40_fault.h) in between, to measure
+ * how the driver recovers from a noisy UART or I2C connection.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src fault.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../host/svm40_fault.cpp ../../src/svm40.cpp ../../src/svm40_bus.cpp -o fault
+ *
+ * Usage :
+ *   fault [options]
+ *
+ *   -i        use I2C (default UART)
+ *   -n n      number of samples to read (default 10000, 1 per second)
+ *   -s n      random seed (default 1)
+ *   -x dir    corrupt rx, tx or both (default rx)
+ *
+ *   fault rates in ppm (per 1.000.000 bytes) :
+ *   -D ppm    drop byte
+ *   -U ppm    duplicate byte
+ *   -L ppm    delay byte by -m mS (default 50 mS)
+ *   -F ppm    flip a bit
+ *   -S ppm    insert stray 0x7E / 0x7D
+ *   -T ppm    truncate I2C answer (per transmission)
+ *   -N ppm    NACK I2C transmission (per transmission)
+ *
+ * Reported :
+ *   lost       : samples not obtained (driver returned an error)
+ *   corrupt    : samples obtained with a wrong value (error not detected)
+ *   lost / 1M  : lost samples per 1.000.000 bytes on the bus
+ *   recover    : time from the first failed sample until the next good one
+ *                (virtual time, so including the driver timeouts)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_fault.h"
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-i] [-n samples] [-s seed] [-x rx|tx|both]\n", name);
+    fprintf(stderr, "        [-D ppm] [-U ppm] [-L ppm] [-m mS] [-F ppm] [-S ppm] [-T ppm] [-N ppm]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    struct svm40_fault_cfg cfg;
+    struct svm40_stats st;
+    struct svm40_raw r, got;
+    SVM40 svm;
+    int opt;
+    bool i2c = false, failing = false;
+    uint32_t samples = 10000, seed = 1, i, lost = 0, corrupt = 0;
+    uint32_t fail_start = 0, t, recoveries = 0, rec_max = 0;
+    double rec_sum = 0;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.delay_ms = 50;
+
+    while ((opt = getopt(argc, argv, "in:s:x:D:U:L:m:F:S:T:N:")) != -1) {
+        switch(opt) {
+            case 'i': i2c = true; break;
+            case 'n': samples = strtoul(optarg, NULL, 0); break;
+            case 's': seed = strtoul(optarg, NULL, 0); break;
+            case 'x':
+                if (strcmp(optarg, "rx") == 0) cfg.dir = SVM40_FAULT_RX;
+                else if (strcmp(optarg, "tx") == 0) cfg.dir = SVM40_FAULT_TX;
+                else if (strcmp(optarg, "both") == 0) cfg.dir = SVM40_FAULT_RX | SVM40_FAULT_TX;
+                else usage(argv[0]);
+                break;
+            case 'D': cfg.drop = strtoul(optarg, NULL, 0); break;
+            case 'U': cfg.dup = strtoul(optarg, NULL, 0); break;
+            case 'L': cfg.delay = strtoul(optarg, NULL, 0); break;
+            case 'm': cfg.delay_ms = strtoul(optarg, NULL, 0); break;
+            case 'F': cfg.flip = strtoul(optarg, NULL, 0); break;
+            case 'S': cfg.stray = strtoul(optarg, NULL, 0); break;
+            case 'T': cfg.truncate = strtoul(optarg, NULL, 0); break;
+            case 'N': cfg.nack = strtoul(optarg, NULL, 0); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    SVM40_Sim sim(i2c ? SVM40_SIM_I2C : SVM40_SIM_UART);
+    SVM40_Fault fault(&sim, seed);
+    fault.SetConfig(&cfg);
+
+    if (i2c) {
+        Wire.begin();
+        Wire.attach(&fault);
+        svm.begin(&Wire);
+    }
+    else
+        svm.begin(&fault);
+
+    for (i = 0; i < samples; i++) {
+
+        // known values to detect corruption
+        r.VOC_index = 1000 + i % 1000;
+        r.humidity = 4000 + i % 2000;
+        r.temperature = 4000 + i % 3000;
+        r.raw_voc_ticks = 30000 + i % 5000;
+        r.raw_humidity = 3800 + i % 2000;
+        r.raw_temperature = 4200 + i % 3000;
+        sim.SetValues(&r);
+
+        t = millis();
+
+        if (svm.GetRawValues(&got) != ERR_OK) {
+            lost++;
+            if (! failing) {
+                failing = true;
+                fail_start = t;
+            }
+        }
+        else {
+            if (memcmp(&got, &r, sizeof(r)) != 0) corrupt++;
+
+            if (failing) {
+                failing = false;
+                t = millis() - fail_start;
+                rec_sum += t;
+                if (t > rec_max) rec_max = t;
+                recoveries++;
+            }
+        }
+
+        // next sample 1 second after the previous
+        t = millis() - t;
+        if (t < 1000) delay(1000 - t);
+    }
+
+    svm.GetStats(&st);
+
+    (printf)("transport     %s\n", i2c ? "I2C" : "UART");
+    (printf)("samples       %u\n", samples);
+    (printf)("bytes         %u\n", fault.GetBytes());
+    (printf)("faults        %u\n", fault.GetFaults());
+    (printf)("lost          %u (%.3f%%)\n", lost, samples ? 100.0 * lost / samples : 0);
+    (printf)("corrupt       %u\n", corrupt);
+    (printf)("lost / 1M     %.1f\n", fault.GetBytes() ? 1e6 * lost / fault.GetBytes() : 0);
+    (printf)("recoveries    %u%s\n", recoveries, failing ? " (still failing at end)" : "");
+    (printf)("recover avg   %.0f mS\n", recoveries ? rec_sum / recoveries : 0);
+    (printf)("recover max   %u mS\n", rec_max);
+    (printf)("driver        ok %u, crc %u, timeout %u, protocol %u, tx %u, rx %u\n",
+             st.frames_ok, st.crc_errors, st.timeouts, st.protocol_errors, st.bytes_tx, st.bytes_rx);
+
+    return(0);
+}
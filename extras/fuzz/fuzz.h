@@ -0,0 +1,134 @@
+/**
+ * SVM40 fuzz targets : common part
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * The input of a fuzz target is :
+ *
+ *   byte 0       the call to make (see fuzz_call())
+ *   then         for each command sent : a length byte and that many
+ *                bytes the sensor answers
+ *
+ * FuzzStream plays the sensor : after the driver sent a command, the next
+ * part of the input is available to read. Bytes left from the part before
+ * are dropped, as a sensor only answers once.
+ *
+ * The driver waits with host_advance() (virtual time), so the timeouts do
+ * not take real time.
+ *********************************************************************
+ */
+#ifndef SVM40_FUZZ_H
+#define SVM40_FUZZ_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "host.h"
+#include "svm40.h"
+
+#define FUZZ_CALLS  10              // number of calls in fuzz_call()
+
+class FuzzStream : public Stream
+{
+  public:
+    FuzzStream(const uint8_t *data, size_t size) :
+        _data(data), _size(size), _pos(0), _end(0), _written(false) {}
+
+    size_t write(uint8_t c) {(void) c; _written = true; return(1);}
+    size_t write(const uint8_t *buf, size_t n) {(void) buf; _written = true; return(n);}
+    using  Print::write;
+
+    int available() {
+        if (_written) Next();
+        return(_end - _pos);
+    }
+
+    int read() {
+        if (_written) Next();
+        return(_pos < _end ? _data[_pos++] : -1);
+    }
+
+    int peek() {
+        if (_written) Next();
+        return(_pos < _end ? _data[_pos] : -1);
+    }
+
+  private:
+    // the answer to the command sent
+    void Next() {
+        size_t n;
+
+        _written = false;
+        _pos = _end;
+        if (_pos >= _size) return;
+
+        n = _data[_pos++];
+        _end = _pos + n > _size ? _size : _pos + n;
+    }
+
+    const uint8_t *_data;
+    size_t        _size;
+    size_t        _pos;             // next byte to read
+    size_t        _end;             // end of the current answer
+    bool          _written;         // a command was sent
+};
+
+// the driver waits in virtual time
+static void fuzz_wait(void *arg, uint32_t ms) {
+    (void) arg;
+    host_advance(ms);
+}
+
+/**
+ * @brief : make a call that reads an answer from the sensor
+ * @param s   : driver
+ * @param sel : call to make
+ */
+static void fuzz_call(SVM40 *s, uint8_t sel) {
+    struct svm40_values v;
+    struct svm40_raw r;
+    struct svm_algopar p;
+    SVM40_version ver;
+    char buf[40];
+    uint8_t state[8];
+    uint32_t up;
+    int16_t off;
+
+    s->SetWait(fuzz_wait);
+
+    switch(sel % FUZZ_CALLS) {
+        case 0: s->GetValues(&v); break;
+        case 1: s->GetRawValues(&r); break;
+        case 2: s->GetVersion(&ver); break;
+        case 3: s->GetSerialNumber(buf, sizeof(buf)); break;
+        case 4: s->GetProductName(buf, sizeof(buf)); break;
+        case 5: s->GetProductType(buf, sizeof(buf)); break;
+        case 6: s->GetVocState(state); break;
+        case 7: s->GetVocTuningParameters(&p); break;
+        case 8: s->GetTemperatureOffset(&off); break;
+        case 9: s->GetSystemUpTime(&up); break;
+    }
+}
+
+#endif /* SVM40_FUZZ_H */
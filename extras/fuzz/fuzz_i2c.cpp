@@ -0,0 +1,50 @@
+/**
+ * SVM40 fuzz target : I2C answers (I2C_ReadFromSVM())
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Feeds the input (see fuzz.h) as the I2C answers of the sensor, so
+ * I2C_ReadFromSVM() and the decoding of each answer are fuzzed. The host
+ * Wire reads the answer in parts of its buffer (BUFFER_LENGTH).
+ * Build with the Makefile in this directory.
+ *********************************************************************
+ */
+
+#include "fuzz.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+
+    if (size < 1) return(0);
+
+    FuzzStream answer(data + 1, size - 1);
+    TwoWire wire;
+    SVM40 s;
+
+    wire.attach(&answer);
+    s.begin(&wire);
+    fuzz_call(&s, data[0]);
+
+    return(0);
+}
@@ -0,0 +1,163 @@
+/**
+ * SVM40 fuzz targets : driver without libFuzzer
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Runs a fuzz target (LLVMFuzzerTestOneInput()) when libFuzzer is not
+ * available, e.g. with g++ and ASan / UBSan or under AFL :
+ *
+ *   fuzz_xxx_run [options] file|directory ...
+ *
+ *   -n n      after the files, run n inputs made by random changes to them
+ *             (default 0)
+ *   -s n      random seed (default 1)
+ *
+ * Each file is an input. With AFL use : afl-fuzz -i corpus/xxx -o out -- fuzz_xxx_afl @@
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define MAX_INPUTS  1024
+#define MAX_SIZE    512
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static uint8_t *inputs[MAX_INPUTS];
+static size_t  sizes[MAX_INPUTS];
+static int     count;
+
+static void load(const char *name) {
+    uint8_t buf[MAX_SIZE];
+    FILE *fp;
+    size_t n;
+
+    if (count == MAX_INPUTS) return;
+
+    if ((fp = fopen(name, "rb")) == NULL) {
+        fprintf(stderr, "can not open %s\n", name);
+        return;
+    }
+
+    n = fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+
+    inputs[count] = (uint8_t *) malloc(n ? n : 1);
+    memcpy(inputs[count], buf, n);
+    sizes[count++] = n;
+}
+
+static void add(const char *name) {
+    char path[512];
+    struct dirent *e;
+    struct stat st;
+    DIR *d;
+
+    if (stat(name, &st) != 0 || ! S_ISDIR(st.st_mode)) {
+        load(name);
+        return;
+    }
+
+    if ((d = opendir(name)) == NULL) return;
+
+    while ((e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", name, e->d_name);
+        load(path);
+    }
+
+    closedir(d);
+}
+
+// random changes : flip, set, insert or remove bytes
+static size_t mutate(uint8_t *buf, size_t n) {
+    int i, changes = 1 + rand() % 4;
+    size_t pos;
+
+    for (i = 0; i < changes; i++) {
+
+        pos = n ? rand() % n : 0;
+
+        switch(rand() % 5) {
+            case 0: if (n) buf[pos] ^= 1 << (rand() % 8); break;
+            case 1: if (n) buf[pos] = rand(); break;
+            case 2: if (n) buf[pos] = (rand() & 1) ? 0x7E : 0x7D; break;
+            case 3:
+                if (n < MAX_SIZE) {
+                    memmove(&buf[pos + 1], &buf[pos], n - pos);
+                    buf[pos] = rand();
+                    n++;
+                }
+                break;
+            case 4:
+                if (n) {
+                    memmove(&buf[pos], &buf[pos + 1], n - pos - 1);
+                    n--;
+                }
+                break;
+        }
+    }
+
+    return(n);
+}
+
+int main(int argc, char *argv[]) {
+    uint8_t buf[MAX_SIZE];
+    long runs = 0, r;
+    size_t n;
+    int opt, i;
+
+    srand(1);
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+        switch(opt) {
+            case 'n': runs = atol(optarg); break;
+            case 's': srand(atoi(optarg)); break;
+            default:
+                fprintf(stderr, "usage : %s [-n runs] [-s seed] file|directory ...\n", argv[0]);
+                return(1);
+        }
+    }
+
+    for (i = optind; i < argc; i++) add(argv[i]);
+
+    for (i = 0; i < count; i++) LLVMFuzzerTestOneInput(inputs[i], sizes[i]);
+
+    for (r = 0; r < runs && count > 0; r++) {
+        i = rand() % count;
+        memcpy(buf, inputs[i], sizes[i]);
+        n = mutate(buf, sizes[i]);
+        LLVMFuzzerTestOneInput(buf, n);
+    }
+
+    printf("%d inputs, %ld random runs\n", count, runs);
+    return(0);
+}
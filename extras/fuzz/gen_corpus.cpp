@@ -0,0 +1,161 @@
+/**
+ * SVM40 fuzz targets : seed corpus from the simulated sensor
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Makes each call of fuzz_call() (fuzz.h) on the simulated sensor
+ * (extras/host/svm40_sim.h) and records the answers in the input format
+ * of the fuzz targets :
+ *
+ *   corpus/shdlc/   UART answers
+ *   corpus/i2c/     I2C answers
+ *
+ * Each call is recorded with the measurement stopped and started.
+ *
+ *   gen_corpus [directory]     (default corpus)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "fuzz.h"
+#include "svm40_sim.h"
+
+#define MAX_REC 512
+
+// passes all to the sensor and records the answers
+class Recorder : public Stream
+{
+  public:
+    Recorder(Stream *dev, uint8_t sel) : _dev(dev), _seg(-1), _written(false) {
+        _rec[0] = sel;
+        _len = 1;
+    }
+
+    size_t write(uint8_t c) {_written = true; return(_dev->write(c));}
+    size_t write(const uint8_t *buf, size_t n) {_written = true; return(_dev->write(buf, n));}
+    using  Print::write;
+
+    int available() {return(_dev->available());}
+    int peek() {return(_dev->peek());}
+
+    int read() {
+        int c = _dev->read();
+
+        if (c < 0 || _len >= MAX_REC) return(c);
+
+        // first byte of the answer to a command : start a new part
+        if (_written || _seg < 0) {
+            if (_len + 1 >= MAX_REC) return(c);
+            _seg = _len;
+            _rec[_len++] = 0;
+            _written = false;
+        }
+
+        if (_rec[_seg] == 255) return(c);
+
+        _rec[_len++] = c;
+        _rec[_seg]++;
+
+        return(c);
+    }
+
+    bool save(const char *name) {
+        FILE *fp = fopen(name, "wb");
+
+        if (fp == NULL) return(false);
+        fwrite(_rec, 1, _len, fp);
+        fclose(fp);
+        return(true);
+    }
+
+  private:
+    Stream  *_dev;
+    uint8_t _rec[MAX_REC];
+    size_t  _len;
+    int     _seg;                   // length byte of the current answer
+    bool    _written;               // a command was sent
+};
+
+static const char *calls[FUZZ_CALLS] = {"values", "raw", "version", "serial",
+    "name", "type", "state", "tuning", "offset", "uptime"};
+
+static int record(const char *dir, uint8_t mode, uint8_t sel, bool started) {
+    char name[256];
+    SVM40_Sim sim(mode);
+
+    // start the measurement without recording
+    if (started) {
+        TwoWire wire;
+        SVM40 s;
+
+        if (mode == SVM40_SIM_I2C) {
+            wire.attach(&sim);
+            s.begin(&wire);
+        }
+        else
+            s.begin(&sim);
+
+        s.start();
+        host_advance(2000);
+    }
+
+    Recorder rec(&sim, sel);
+    TwoWire wire;
+    SVM40 s;
+
+    if (mode == SVM40_SIM_I2C) {
+        wire.attach(&rec);
+        s.begin(&wire);
+    }
+    else
+        s.begin(&rec);
+
+    fuzz_call(&s, sel);
+
+    snprintf(name, sizeof(name), "%s/%s/%s%s", dir, mode == SVM40_SIM_I2C ? "i2c" : "shdlc",
+             calls[sel], started ? "_started" : "");
+
+    if (! rec.save(name)) {
+        fprintf(stderr, "can not write %s\n", name);
+        return(1);
+    }
+
+    return(0);
+}
+
+int main(int argc, char *argv[]) {
+    const char *dir = argc > 1 ? argv[1] : "corpus";
+    int err = 0;
+
+    for (uint8_t sel = 0; sel < FUZZ_CALLS; sel++) {
+        err |= record(dir, SVM40_SIM_UART, sel, false);
+        err |= record(dir, SVM40_SIM_UART, sel, true);
+        err |= record(dir, SVM40_SIM_I2C, sel, false);
+        err |= record(dir, SVM40_SIM_I2C, sel, true);
+    }
+
+    return(err);
+}
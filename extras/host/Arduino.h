@@ -0,0 +1,129 @@
+/**
+ * SVM40 Library host (Linux) build : Arduino.h
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Just enough of the Arduino API to compile the library on Linux. See
+ * host.h for details.
+ *********************************************************************
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+
+// printf.h would route printf() to Serial, on Linux we have the real one
+#define _printf_h_
+
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+#define noInterrupts()
+#define interrupts()
+
+class __FlashStringHelper;
+#define F(x) (reinterpret_cast<const __FlashStringHelper *>(x))
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t n) {
+        size_t i;
+        for (i = 0; i < n; i++) if (write(buf[i]) == 0) break;
+        return(i);
+    }
+    size_t write(const char *s) {return(write((const uint8_t *) s, strlen(s)));}
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper *s) {return(write((const char *) s));}
+    size_t print(const char *s) {return(write(s));}
+    size_t print(char c) {return(write((uint8_t) c));}
+    size_t print(int n, int base = DEC) {return(print((long) n, base));}
+    size_t print(unsigned int n, int base = DEC) {return(print((unsigned long) n, base));}
+    size_t print(long n, int base = DEC) {
+        if (base == DEC) return(Format("%ld", n));
+        return(print((unsigned long) n, base));
+    }
+    size_t print(unsigned long n, int base = DEC) {
+        return(Format(base == HEX ? "%lX" : "%lu", n));
+    }
+    size_t print(unsigned char n, int base = DEC) {return(print((unsigned long) n, base));}
+    size_t print(double n, int digits = 2) {return(Format("%.*f", digits, n));}
+
+    template <class T> size_t println(T v) {size_t n = print(v); return(n + println());}
+    template <class T> size_t println(T v, int f) {size_t n = print(v, f); return(n + println());}
+    size_t println() {return(write("\r\n"));}
+
+  private:
+    size_t Format(const char *fmt, ...) {
+        char buf[32];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        return(write(buf));
+    }
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+// Serial : output to stdout, no input
+class HardwareSerial : public Stream
+{
+  public:
+    void   begin(unsigned long) {}
+    size_t write(uint8_t c) {return(fputc(c, stdout) == EOF ? 0 : 1);}
+    using  Print::write;
+    int    available() {return(0);}
+    int    read() {return(-1);}
+    int    peek() {return(-1);}
+    void   flush() {fflush(stdout);}
+    operator bool() {return(true);}
+};
+
+extern HardwareSerial Serial;
+
+#endif /* HOST_ARDUINO_H */
@@ -0,0 +1,108 @@
+/**
+ * SVM40 Library host (Linux) build : Wire.h
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * TwoWire that passes the bytes to a Stream instead of an I2C bus :
+ *  - endTransmission() writes the bytes to the device, if the device
+ *    does not accept them (write() returns 0) this is a NACK
+ *  - requestFrom() reads the bytes from the device
+ *
+ *   Wire.begin();
+ *   Wire.attach(&device);
+ *********************************************************************
+ */
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32            // as on AVR, -DBUFFER_LENGTH= to change
+#endif
+
+class TwoWire : public Stream
+{
+  public:
+    TwoWire() : _dev(NULL), _txlen(0), _rxlen(0), _rxpos(0) {}
+
+    /**
+     * @brief : set the device (NULL = no device, every transmission NACK)
+     */
+    void    attach(Stream *dev) {_dev = dev;}
+
+    void    begin() {}
+    void    setClock(uint32_t) {}
+
+    void    beginTransmission(uint8_t) {_txlen = 0;}
+
+    uint8_t endTransmission(bool stop = true) {
+        (void) stop;
+        size_t n;
+
+        if (_dev == NULL) return(2);                // NACK on address
+        n = _dev->write(_tx, _txlen);
+        _txlen = 0;
+        return(n == 0 ? 2 : 0);                     // device did not accept
+    }
+
+    uint8_t requestFrom(uint8_t addr, uint8_t cnt, bool stop = true) {
+        int c;
+        (void) addr; (void) stop;
+
+        _rxlen = _rxpos = 0;
+        if (_dev == NULL) return(0);
+        if (cnt > BUFFER_LENGTH) cnt = BUFFER_LENGTH;
+
+        while (_rxlen < cnt) {
+            if ((c = _dev->read()) < 0) break;
+            _rx[_rxlen++] = (uint8_t) c;
+        }
+        return(_rxlen);
+    }
+
+    size_t  write(uint8_t c) {
+        if (_txlen >= BUFFER_LENGTH) return(0);
+        _tx[_txlen++] = c;
+        return(1);
+    }
+    using   Print::write;
+
+    int     available() {return(_rxlen - _rxpos);}
+    int     read() {return(_rxpos < _rxlen ? _rx[_rxpos++] : -1);}
+    int     peek() {return(_rxpos < _rxlen ? _rx[_rxpos] : -1);}
+
+  private:
+    Stream  *_dev;
+    uint8_t _tx[BUFFER_LENGTH];
+    uint8_t _txlen;
+    uint8_t _rx[BUFFER_LENGTH];
+    uint8_t _rxlen;
+    uint8_t _rxpos;
+};
+
+extern TwoWire Wire;
+
+#endif /* HOST_WIRE_H */
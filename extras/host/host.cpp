@@ -0,0 +1,151 @@
+/**
+ * SVM40 Library host (Linux) build
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ * - virtual clock per thread
+ *********************************************************************
+ */
+
+#include <time.h>
+#include <sched.h>
+#include "host.h"
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+// each thread has its own virtual clock, so several threads can each
+// drive their own sensors without seeing each others delay()
+static thread_local unsigned long long skipped_us = 0; // added by delay()
+static bool realtime = false;                  // delay() waits
+
+/**
+ * @brief : monotonic time in uS
+ */
+static unsigned long long now_us() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((unsigned long long) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief : real time in uS since first call
+ */
+static unsigned long long real_us() {
+    static const unsigned long long start = now_us();  // thread safe init
+    return(now_us() - start);
+}
+
+unsigned long micros() {
+    return((unsigned long) (real_us() + skipped_us));
+}
+
+unsigned long millis() {
+    return((unsigned long) ((real_us() + skipped_us) / 1000));
+}
+
+void delay(unsigned long ms) {
+    struct timespec ts;
+
+    if (! realtime) {
+        host_advance(ms);
+        return;
+    }
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+void yield() {
+    sched_yield();
+}
+
+void host_advance(unsigned long ms) {
+    if (realtime) return;
+    skipped_us += (unsigned long long) ms * 1000;
+}
+
+void host_realtime(bool act) {
+    realtime = act;
+}
+
+unsigned long host_skipped() {
+    return((unsigned long) (skipped_us / 1000));
+}
+
+/*******************************************************************
+ *  FILESTREAM
+ *******************************************************************/
+
+bool FileStream::open(const char *name, const char *mode) {
+    close();
+    _fp = fopen(name, mode);
+    return(_fp != NULL);
+}
+
+void FileStream::close() {
+    if (_fp) fclose(_fp);
+    _fp = NULL;
+    _peek = -1;
+}
+
+size_t FileStream::write(uint8_t c) {
+    if (_fp == NULL) return(0);
+    return(fputc(c, _fp) == EOF ? 0 : 1);
+}
+
+size_t FileStream::write(const uint8_t *buf, size_t n) {
+    if (_fp == NULL) return(0);
+    return(fwrite(buf, 1, n, _fp));
+}
+
+int FileStream::available() {
+    return(peek() < 0 ? 0 : 1);
+}
+
+int FileStream::read() {
+    int c;
+
+    if (_fp == NULL) return(-1);
+
+    if (_peek >= 0) {
+        c = _peek;
+        _peek = -1;
+        return(c);
+    }
+
+    c = fgetc(_fp);
+    return(c == EOF ? -1 : c);
+}
+
+int FileStream::peek() {
+    if (_peek < 0) _peek = read();
+    return(_peek);
+}
+
+void FileStream::flush() {
+    if (_fp) fflush(_fp);
+}
@@ -0,0 +1,99 @@
+/**
+ * SVM40 Library host (Linux) build
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Allows to compile the library (and tools using it) on Linux, e.g. to
+ * replay a capture (extras/replay). Add this directory to the include
+ * path BEFORE the src directory and compile host.cpp with the program :
+ *
+ *   g++ -O2 -I../host -I../../src prog.cpp ../host/host.cpp ../../src/svm40.cpp \
+ *       ../../src/svm40_bus.cpp
+ *
+ * Serial writes to stdout. Wire passes all bytes to a Stream (Wire.attach()).
+ *
+ * The clock is virtual : millis() is the real time plus the time that
+ * delay() was called for. delay() does NOT wait, so the driver runs at
+ * full speed while it still sees the expected time passing. Call
+ * host_realtime(true) to have delay() really wait. Each thread has its own
+ * virtual clock, in real time all threads share the same clock.
+ *********************************************************************
+ */
+#ifndef HOST_H
+#define HOST_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+/**
+ * @brief : advance the virtual clock without waiting
+ * @param ms : mS to add
+ *
+ * Ignored in real time mode.
+ */
+void host_advance(unsigned long ms);
+
+/**
+ * @brief : total mS added by delay() and host_advance()
+ */
+unsigned long host_skipped();
+
+/**
+ * @brief : select real time (delay() waits) or virtual time (default)
+ */
+void host_realtime(bool act);
+
+// file as Stream (read and / or write)
+class FileStream : public Stream
+{
+  public:
+    FileStream() : _fp(NULL), _peek(-1) {}
+    ~FileStream() {close();}
+
+    /**
+     * @brief : open file
+     * @param name : file name
+     * @param mode : as fopen() e.g. "rb" or "wb"
+     *
+     * @return :
+     *  true if opened else false
+     */
+    bool   open(const char *name, const char *mode);
+    void   close();
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t n);
+    using  Print::write;
+    int    available();
+    int    read();
+    int    peek();
+    void   flush();
+
+  private:
+    FILE   *_fp;
+    int    _peek;
+};
+
+#endif /* HOST_H */
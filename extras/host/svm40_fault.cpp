@@ -0,0 +1,198 @@
+/**
+ * SVM40 Library host (Linux) build : fault injection
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_fault.h"
+
+/**
+ * @brief constructor
+ * @param dev  : device to pass the bytes to
+ * @param seed : start of the random sequence
+ */
+SVM40_Fault::SVM40_Fault(Stream *dev, uint32_t seed) {
+    _dev = dev;
+    memset(&_cfg, 0, sizeof(_cfg));
+    Seed(seed);
+    _bytes = _faults = 0;
+    _limit = -1;
+    _head = _count = 0;
+}
+
+/**
+ * @brief : xorshift32
+ */
+uint32_t SVM40_Fault::Random() {
+    _rnd ^= _rnd << 13;
+    _rnd ^= _rnd >> 17;
+    _rnd ^= _rnd << 5;
+    return(_rnd);
+}
+
+/**
+ * @brief : decide on a fault
+ * @param ppm : chance in parts per million
+ */
+bool SVM40_Fault::Hit(uint32_t ppm) {
+    if (ppm == 0) return(false);
+    if (Random() % 1000000 >= ppm) return(false);
+    _faults++;
+    return(true);
+}
+
+/**
+ * @brief : byte to the device (UART)
+ */
+size_t SVM40_Fault::write(uint8_t c) {
+
+    _bytes++;
+
+    if (_cfg.dir & SVM40_FAULT_TX) {
+        if (Hit(_cfg.drop)) return(1);
+        if (Hit(_cfg.flip)) c ^= 1 << (Random() % 8);
+        if (Hit(_cfg.stray)) _dev->write(Random() & 1 ? 0x7E : 0x7D);
+        if (Hit(_cfg.dup)) _dev->write(c);
+    }
+
+    _dev->write(c);
+    return(1);
+}
+
+/**
+ * @brief : I2C transmission to the device
+ *
+ * @return : 0 = NACK, else n
+ */
+size_t SVM40_Fault::write(const uint8_t *buf, size_t n) {
+    uint8_t tx[SVM40_FAULT_QUE * 4];
+    size_t i;
+
+    _bytes += n;
+
+    if (Hit(_cfg.nack)) return(0);
+
+    if (n > sizeof(tx)) n = sizeof(tx);
+    memcpy(tx, buf, n);
+
+    if (_cfg.dir & SVM40_FAULT_TX) {
+        for (i = 0; i < n; i++) {
+            if (Hit(_cfg.flip)) tx[i] ^= 1 << (Random() % 8);
+        }
+    }
+
+    // answer of the device is kept until read
+    _head = _count = 0;
+    _dev->write(tx, n);
+
+    _limit = -1;
+    if (Hit(_cfg.truncate)) _limit = Random() % (_dev->available() + 1);
+
+    return(n);
+}
+
+/**
+ * @brief : add byte to the queue
+ * @param c  : byte
+ * @param at : millis() the byte is available
+ */
+void SVM40_Fault::Push(uint8_t c, uint32_t at) {
+    uint8_t i;
+
+    if (_count == SVM40_FAULT_QUE) return;
+
+    i = (_head + _count++) % SVM40_FAULT_QUE;
+    _que[i] = c;
+    _at[i] = at;
+}
+
+/**
+ * @brief : get a byte from the device and inject faults
+ */
+void SVM40_Fault::Fill() {
+    uint32_t now, at;
+    int c;
+
+    while (_count < SVM40_FAULT_QUE - 3) {
+
+        if (_limit == 0) return;
+        if (_dev->available() == 0) return;
+        if ((c = _dev->read()) < 0) return;
+
+        if (_limit > 0) _limit--;
+
+        _bytes++;
+
+        now = millis();
+
+        // queue keeps the order : a delay holds the bytes after it as well
+        at = _count > 0 ? _at[(_head + _count - 1) % SVM40_FAULT_QUE] : now;
+
+        if (_cfg.dir == 0 || (_cfg.dir & SVM40_FAULT_RX)) {
+
+            if (Hit(_cfg.drop)) continue;
+            if (Hit(_cfg.flip)) c ^= 1 << (Random() % 8);
+            if (Hit(_cfg.delay)) at = now + _cfg.delay_ms;
+            if (Hit(_cfg.stray)) Push(Random() & 1 ? 0x7E : 0x7D, at);
+            if (Hit(_cfg.dup)) Push(c, at);
+        }
+
+        Push(c, at);
+    }
+}
+
+int SVM40_Fault::available() {
+    uint8_t i, n;
+    uint32_t now;
+
+    Fill();
+
+    now = millis();
+
+    for (i = 0, n = 0; i < _count; i++, n++) {
+        if ((int32_t) (now - _at[(_head + i) % SVM40_FAULT_QUE]) < 0) break;
+    }
+
+    if (n == 0) host_advance(1);
+    return(n);
+}
+
+int SVM40_Fault::read() {
+    uint8_t c;
+
+    if (available() == 0) return(-1);
+
+    c = _que[_head];
+    _head = (_head + 1) % SVM40_FAULT_QUE;
+    _count--;
+
+    return(c);
+}
+
+int SVM40_Fault::peek() {
+    if (available() == 0) return(-1);
+    return(_que[_head]);
+}
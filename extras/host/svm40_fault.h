@@ -0,0 +1,123 @@
+/**
+ * SVM40 Library host (Linux) build : fault injection
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * A Stream placed between the driver and a (simulated) device that
+ * corrupts the traffic :
+ *
+ *   SVM40_Sim   sim(SVM40_SIM_UART);
+ *   SVM40_Fault fault(&sim, seed);
+ *   struct svm40_fault_cfg cfg = {};
+ *   cfg.flip = 100;                  // 100 ppm of the bytes get a bit flipped
+ *   fault.SetConfig(&cfg);
+ *   svm40.begin(&fault);             // or Wire.attach(&fault)
+ *
+ * All rates are in ppm (faults per 1.000.000 bytes). The random sequence
+ * only depends on the seed, so a run can be repeated exactly.
+ *
+ * On I2C, write(buf, n) is a complete transmission (see host Wire.h). A
+ * transmission can be refused (NACK) and the answer to it truncated.
+ *
+ * Polling available() while there is nothing to read advances the virtual
+ * clock (host.h) by 1 mS, so a driver timeout takes no real time.
+ *********************************************************************
+ */
+#ifndef SVM40_FAULT_H
+#define SVM40_FAULT_H
+
+#include "host.h"
+
+#define SVM40_FAULT_RX   0x01           // corrupt bytes from the device
+#define SVM40_FAULT_TX   0x02           // corrupt bytes to the device
+#define SVM40_FAULT_QUE  16
+
+struct svm40_fault_cfg
+{
+    uint32_t   drop;               // byte is lost
+    uint32_t   dup;                // byte is received twice
+    uint32_t   delay;              // byte arrives delay_ms later
+    uint32_t   flip;               // a bit in the byte is inverted
+    uint32_t   stray;              // a 0x7E or 0x7D is inserted before the byte
+    uint32_t   truncate;           // I2C : answer is cut short (ppm of transmissions)
+    uint32_t   nack;               // I2C : transmission NACK (ppm of transmissions)
+    uint16_t   delay_ms;           // delay for a delayed byte
+    uint8_t    dir;                // SVM40_FAULT_RX and / or SVM40_FAULT_TX (0 = RX)
+};
+
+class SVM40_Fault : public Stream
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param dev  : device to pass the bytes to
+     * @param seed : start of the random sequence
+     */
+    SVM40_Fault(Stream *dev, uint32_t seed = 1);
+
+    void     SetConfig(struct svm40_fault_cfg *cfg) {_cfg = *cfg;}
+
+    /**
+     * @brief : restart the random sequence
+     */
+    void     Seed(uint32_t seed) {_rnd = seed ? seed : 1;}
+
+    /**
+     * @brief : number of bytes passed / faults injected
+     */
+    uint32_t GetBytes()  {return(_bytes);}
+    uint32_t GetFaults() {return(_faults);}
+    void     ClearCounters() {_bytes = _faults = 0;}
+
+    // Stream
+    size_t   write(uint8_t c);
+    size_t   write(const uint8_t *buf, size_t n);
+    int      available();
+    int      read();
+    int      peek();
+
+  private:
+
+    bool     Hit(uint32_t ppm);
+    uint32_t Random();
+    void     Fill();
+    void     Push(uint8_t c, uint32_t at);
+
+    Stream   *_dev;
+    struct svm40_fault_cfg _cfg;
+    uint32_t _rnd;
+    uint32_t _bytes;
+    uint32_t _faults;
+    int32_t  _limit;                // I2C : bytes left in answer (-1 = no limit)
+
+    // bytes from the device after fault injection
+    uint8_t  _que[SVM40_FAULT_QUE];
+    uint32_t _at[SVM40_FAULT_QUE];  // millis() the byte is available
+    uint8_t  _head;
+    uint8_t  _count;
+};
+
+#endif /* SVM40_FAULT_H */
@@ -0,0 +1,79 @@
+/**
+ * SVM40 host file storage for checkpoints
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Stores the checkpoints (svm40_checkpoint.h) in a file on Linux :
+ *
+ *   SVM40_FileStorage store("/var/lib/svm40.cp", 200);  // 10 slots
+ *
+ * The file is created if it does not exist. Each write is flushed and
+ * synced to disk.
+ *********************************************************************
+ */
+#ifndef SVM40_FILE_STORAGE_H
+#define SVM40_FILE_STORAGE_H
+
+#include <stdio.h>
+#include <unistd.h>
+#include "svm40_checkpoint.h"
+
+class SVM40_FileStorage : public SVM40_Storage
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param name : file to use
+     * @param size : number of bytes to use
+     */
+    SVM40_FileStorage(const char *name, uint16_t size) : _size(size) {
+        if ((_fp = fopen(name, "r+b")) == NULL) _fp = fopen(name, "w+b");
+    }
+
+    ~SVM40_FileStorage() {if (_fp) fclose(_fp);}
+
+    uint16_t Size() {return(_fp ? _size : 0);}
+
+    bool Read(uint16_t addr, uint8_t *buf, uint8_t len) {
+        if (_fp == NULL || addr + len > _size) return(false);
+        if (fseek(_fp, addr, SEEK_SET) != 0) return(false);
+        return(fread(buf, 1, len, _fp) == len);
+    }
+
+    bool Write(uint16_t addr, const uint8_t *buf, uint8_t len) {
+        if (_fp == NULL || addr + len > _size) return(false);
+        if (fseek(_fp, addr, SEEK_SET) != 0) return(false);
+        if (fwrite(buf, 1, len, _fp) != len) return(false);
+        if (fflush(_fp) != 0) return(false);
+        return(fsync(fileno(_fp)) == 0);
+    }
+
+  private:
+    FILE     *_fp;
+    uint16_t _size;
+};
+
+#endif /* SVM40_FILE_STORAGE_H */
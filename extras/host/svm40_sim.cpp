@@ -0,0 +1,494 @@
+/**
+ * SVM40 Library host (Linux) build : sensor simulator
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "host.h"
+#include "svm40_sim.h"
+
+// commands (same for UART and I2C)
+enum sim_op {
+    OP_START, OP_STOP, OP_RESET, OP_VERSION, OP_UPTIME, OP_READ, OP_READ_RAW,
+    OP_GET_TOFF, OP_SET_TOFF, OP_GET_TUNING, OP_SET_TUNING, OP_NVRAM,
+    OP_GET_STATE, OP_SET_STATE, OP_TYPE, OP_NAME, OP_SERIAL, OP_UNKNOWN
+};
+
+static const char *sim_serial = "SIM0000000000001";
+static const char *sim_type = "00140000";
+static const char *sim_name = "SVM40";
+
+/**
+ * @brief constructor
+ * @param mode : SVM40_SIM_UART or SVM40_SIM_I2C
+ */
+SVM40_Sim::SVM40_Sim(uint8_t mode) {
+    _mode = mode;
+    _fixed = false;
+    _sample = 0;
+    _commands = _refused = 0;
+    Reset();
+}
+
+/**
+ * @brief : power-on reset of the simulated sensor
+ */
+void SVM40_Sim::Reset() {
+    _started = false;
+    _boot = millis();
+    _toffset = 0;
+    _tuning[0] = 100;
+    _tuning[1] = 12;
+    _tuning[2] = 180;
+    _tuning[3] = 50;
+    memset(_vocstate, 0, sizeof(_vocstate));
+    _inlen = _outlen = _outpos = 0;
+    _stuff = false;
+}
+
+/**
+ * @brief : set the values returned by the next reads
+ * @param r : values (NULL = generate values)
+ */
+void SVM40_Sim::SetValues(struct svm40_raw *r) {
+    _fixed = (r != NULL);
+    if (_fixed) _raw = *r;
+}
+
+/**
+ * @brief : store 12 bytes of measurement values (MSB first)
+ */
+void SVM40_Sim::Values(uint8_t *resp) {
+    struct svm40_raw r;
+    uint16_t w[6];
+    uint8_t i;
+    double n;
+
+    if (_fixed) r = _raw;
+    else {
+        n = _sample++;
+        r.raw_temperature = (int16_t) ((23.5 + sin(n / 600)) * 200);
+        r.raw_humidity = (int16_t) ((43 + 5 * sin(n / 900)) * 100);
+        r.raw_voc_ticks = (uint16_t) (30000 + 200 * sin(n / 300));
+        r.VOC_index = (uint16_t) ((100 + 20 * sin(n / 300)) * 10);
+        r.temperature = r.raw_temperature - 200 - _toffset;
+        r.humidity = r.raw_humidity + 200;
+    }
+
+    w[0] = r.VOC_index;
+    w[1] = r.humidity;
+    w[2] = r.temperature;
+    w[3] = r.raw_voc_ticks;
+    w[4] = r.raw_humidity;
+    w[5] = r.raw_temperature;
+
+    for (i = 0; i < 6; i++) {
+        resp[i * 2] = w[i] >> 8;
+        resp[i * 2 + 1] = w[i] & 0xff;
+    }
+}
+
+/**
+ * @brief : handle a command
+ * @param op   : command
+ * @param par  : parameter bytes
+ * @param len  : number of parameter bytes
+ * @param resp : to store answer
+ * @param rlen : to store number of answer bytes
+ *
+ * @return : state (SVM40_ERR_OK or error)
+ */
+uint8_t SVM40_Sim::Command(uint16_t op, uint8_t *par, uint8_t len, uint8_t *resp, uint8_t *rlen) {
+    const char *s;
+    uint32_t up;
+    uint8_t i;
+
+    *rlen = 0;
+    _commands++;
+
+    switch(op) {
+
+        case OP_START:
+            if (_started) return(SVM40_ERR_STAT);
+            _started = true;
+            break;
+
+        case OP_STOP:
+            _started = false;
+            break;
+
+        case OP_RESET:
+            Reset();
+            break;
+
+        case OP_VERSION:
+            resp[0] = 2; resp[1] = 2;               // firmware
+            resp[2] = 0;                            // debug
+            resp[3] = 1; resp[4] = 0;               // hardware
+            resp[5] = 1; resp[6] = 0;               // protocol
+            resp[7] = 0;
+            *rlen = _mode == SVM40_SIM_UART ? 7 : 8;
+            break;
+
+        case OP_UPTIME:
+            up = (millis() - _boot) / 1000;
+            for (i = 0; i < 4; i++) resp[i] = up >> (24 - i * 8);
+            *rlen = 4;
+            break;
+
+        case OP_READ:
+        case OP_READ_RAW:
+            if (! _started) return(SVM40_ERR_STAT);
+            Values(resp);
+            *rlen = 12;
+            if (op == OP_READ) *rlen = 6;
+            break;
+
+        case OP_GET_TOFF:
+            resp[0] = _toffset >> 8;
+            resp[1] = _toffset & 0xff;
+            *rlen = 2;
+            break;
+
+        case OP_SET_TOFF:
+            if (_started) return(SVM40_ERR_STAT);
+            if (len != 2) return(SVM40_ERR_DATA);
+            _toffset = (par[0] << 8) | par[1];
+            break;
+
+        case OP_GET_TUNING:
+            for (i = 0; i < 4; i++) {
+                resp[i * 2] = _tuning[i] >> 8;
+                resp[i * 2 + 1] = _tuning[i] & 0xff;
+            }
+            *rlen = 8;
+            break;
+
+        case OP_SET_TUNING:
+            if (_started) return(SVM40_ERR_STAT);
+            if (len != 8) return(SVM40_ERR_DATA);
+            for (i = 0; i < 4; i++) _tuning[i] = (par[i * 2] << 8) | par[i * 2 + 1];
+            break;
+
+        case OP_NVRAM:
+            break;
+
+        case OP_GET_STATE:
+            if (! _started) return(SVM40_ERR_STAT);
+            memcpy(resp, _vocstate, 8);
+            *rlen = 8;
+            break;
+
+        case OP_SET_STATE:
+            if (_started) return(SVM40_ERR_STAT);
+            if (len != 8) return(SVM40_ERR_DATA);
+            memcpy(_vocstate, par, 8);
+            break;
+
+        case OP_TYPE:
+        case OP_NAME:
+        case OP_SERIAL:
+            s = op == OP_TYPE ? sim_type : op == OP_NAME ? sim_name : sim_serial;
+            *rlen = strlen(s) + 1;
+            memcpy(resp, s, *rlen);
+            break;
+
+        default:
+            return(SVM40_ERR_UCMD);
+    }
+
+    return(SVM40_ERR_OK);
+}
+
+/**
+ * @brief : byte written by the driver
+ */
+size_t SVM40_Sim::write(uint8_t c) {
+
+    if (_mode == SVM40_SIM_I2C) {
+        I2cCommand(&c, 1);
+        return(1);
+    }
+
+    if (c == SHDLC_IND) {
+        if (_inlen > 0) UartFrame();
+        _inlen = 0;
+        _stuff = false;
+        return(1);
+    }
+
+    if (c == 0x7D) {
+        _stuff = true;
+        return(1);
+    }
+
+    if (_stuff) {
+        c ^= 0x20;
+        _stuff = false;
+    }
+
+    if (_inlen < SVM40_SIM_BUF) _in[_inlen++] = c;
+
+    return(1);
+}
+
+/**
+ * @brief : bytes written by the driver
+ *
+ * On I2C this is a complete transmission (see host Wire.h)
+ */
+size_t SVM40_Sim::write(const uint8_t *buf, size_t n) {
+    size_t i;
+
+    if (_mode == SVM40_SIM_I2C) I2cCommand(buf, n);
+    else for (i = 0; i < n; i++) write(buf[i]);
+
+    return(n);
+}
+
+int SVM40_Sim::available() {
+    if (_outpos < _outlen) return(_outlen - _outpos);
+    host_advance(1);
+    return(0);
+}
+
+int SVM40_Sim::read() {
+    if (_outpos >= _outlen) return(-1);
+    return(_out[_outpos++]);
+}
+
+int SVM40_Sim::peek() {
+    if (_outpos >= _outlen) return(-1);
+    return(_out[_outpos]);
+}
+
+/*******************************************************************
+ *  UART
+ *******************************************************************/
+
+/**
+ * @brief : handle a received frame
+ *
+ * _in : addr cmd len data....data crc
+ */
+void SVM40_Sim::UartFrame() {
+    uint8_t resp[SVM40_SIM_BUF], rlen, i, sum, sub, state;
+    uint16_t op;
+
+    if (_inlen < 4 || _in[2] != _inlen - 4) {
+        _refused++;
+        return;
+    }
+
+    for (i = 0, sum = 0; i < _inlen - 1; i++) sum += _in[i];
+    if ((uint8_t) ~sum != _in[_inlen - 1]) {
+        _refused++;
+        return;
+    }
+
+    sub = _in[2] > 0 ? _in[3] : 0xff;
+
+    switch(_in[1]) {
+        case SVM40_SHDLC_START_MEASURE:     op = OP_START; break;
+        case SVM40_SHDLC_STOP_MEASURE:      op = OP_STOP; break;
+        case SVM40_SHDLC_RESET:             op = OP_RESET; break;
+        case SVM40_SHDLC_GET_VERSION:       op = OP_VERSION; break;
+        case SVM40_SHDLC_SYSTEM_UPTIME:     op = OP_UPTIME; break;
+
+        case SVM40_SHDLC_READ_BASE:
+            op = sub == SVM40_SHDLC_READ_RESULTS_INT ? OP_READ :
+                 sub == SVM40_SHDLC_READ_RESULTS_INT_RAW ? OP_READ_RAW : OP_UNKNOWN;
+            break;
+
+        case SVM40_SHDLC_BASELINE_ALG:
+            op = sub == SVM40_SHDLC_GET_TEMP_OFFSET ? OP_GET_TOFF :
+                 sub == SVM40_SHDLC_SET_TEMP_OFFSET ? OP_SET_TOFF :
+                 sub == SVM40_SHDLC_GET_VOC_TUNING ? OP_GET_TUNING :
+                 sub == SVM40_SHDLC_SET_VOC_TUNING ? OP_SET_TUNING :
+                 sub == SVM40_SHDLC_STORE_NVRAM ? OP_NVRAM : OP_UNKNOWN;
+            break;
+
+        case SVM40_SHDLC_BASELINE_STATE:
+            op = sub == SVM40_SHDLC_GET_VOC_STATE ? OP_GET_STATE :
+                 sub == SVM40_SHDLC_SET_VOC_STATE ? OP_SET_STATE : OP_UNKNOWN;
+            break;
+
+        case SVM40_SHDLC_GET_DEVICE_INFO:
+            op = sub == SVM40_SHDLC_DEVICE_PRODUCT_TYPE ? OP_TYPE :
+                 sub == SVM40_SHDLC_DEVICE_PRODUCT_NAME ? OP_NAME :
+                 sub == SVM40_SHDLC_DEVICE_SERIAL ? OP_SERIAL : OP_UNKNOWN;
+            break;
+
+        default:
+            op = OP_UNKNOWN;
+    }
+
+    // parameters after the sub command
+    i = _in[2] > 1 ? _in[2] - 1 : 0;
+
+    state = Command(op, &_in[4], i, resp, &rlen);
+    if (state != SVM40_ERR_OK) _refused++;
+
+    UartAnswer(_in[1], state, resp, rlen);
+}
+
+/**
+ * @brief : add byte to answer, with byte stuffing
+ */
+void SVM40_Sim::UartAdd(uint8_t c) {
+
+    if (_outlen >= SVM40_SIM_BUF - 1) return;
+
+    if (c == 0x7E || c == 0x7D || c == 0x11 || c == 0x13) {
+        _out[_outlen++] = 0x7D;
+        c ^= 0x20;
+    }
+
+    _out[_outlen++] = c;
+}
+
+/**
+ * @brief : create answer frame
+ *
+ * hdr addr cmd state length data....data crc hdr
+ */
+void SVM40_Sim::UartAnswer(uint8_t cmd, uint8_t state, uint8_t *data, uint8_t len) {
+    uint8_t i, sum;
+
+    // remove what was read
+    if (_outpos > 0) {
+        memmove(_out, &_out[_outpos], _outlen - _outpos);
+        _outlen -= _outpos;
+        _outpos = 0;
+    }
+
+    if (_outlen + 2 * len + 12 > SVM40_SIM_BUF) return;
+
+    sum = cmd + state + len;
+
+    _out[_outlen++] = SHDLC_IND;
+    UartAdd(0);
+    UartAdd(cmd);
+    UartAdd(state);
+    UartAdd(len);
+
+    for (i = 0; i < len; i++) {
+        UartAdd(data[i]);
+        sum += data[i];
+    }
+
+    UartAdd(~sum);
+    _out[_outlen++] = SHDLC_IND;
+}
+
+/*******************************************************************
+ *  I2C
+ *******************************************************************/
+
+/**
+ * @brief : CRC of 2 bytes
+ */
+uint8_t SVM40_Sim::I2cCRC(const uint8_t *data) {
+    uint8_t crc = 0xFF, i, bit;
+
+    for (i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (bit = 8; bit > 0; --bit) {
+            if (crc & 0x80) crc = (crc << 1) ^ 0x31;
+            else crc = (crc << 1);
+        }
+    }
+    return(crc);
+}
+
+/**
+ * @brief : handle a transmission
+ *
+ * cmd(2) [data(2) crc(1)] ...
+ * If the command fails, no answer is available (the sensor would NACK)
+ */
+void SVM40_Sim::I2cCommand(const uint8_t *buf, size_t n) {
+    uint8_t par[SVM40_SIM_BUF], resp[SVM40_SIM_BUF], len, rlen, i;
+    uint16_t cmd, op;
+    bool set;
+
+    _outlen = _outpos = 0;
+
+    if (n < 2) {
+        _refused++;
+        return;
+    }
+
+    cmd = (buf[0] << 8) | buf[1];
+
+    // parameters
+    for (i = 2, len = 0; (size_t) i + 3 <= n; i += 3) {
+
+        if (I2cCRC(&buf[i]) != buf[i + 2]) {
+            _refused++;
+            return;
+        }
+
+        par[len++] = buf[i];
+        par[len++] = buf[i + 1];
+    }
+
+    set = len > 0;
+
+    switch(cmd) {
+        case SVM40_I2C_START_MEASURE:       op = OP_START; break;
+        case SVM40_I2C_STOP_MEASURE:        op = OP_STOP; break;
+        case SVM40_I2C_RESET:               op = OP_RESET; break;
+        case SVM40_I2C_GET_VERSION:         op = OP_VERSION; break;
+        case SVM40_I2C_GET_ID:              op = OP_SERIAL; break;
+        case SVM40_I2C_READ_RESULTS_INT:    op = OP_READ; break;
+        case SVM40_I2C_READ_RESULTS_INT_R:  op = OP_READ_RAW; break;
+        case SVM40_I2C_GET_TEMP_OFFSET:     op = set ? OP_SET_TOFF : OP_GET_TOFF; break;
+        case SVM40_I2C_GET_VOC_STATE:       op = set ? OP_SET_STATE : OP_GET_STATE; break;
+        case SVM40_I2C_GET_VOC_TUNING:      op = set ? OP_SET_TUNING : OP_GET_TUNING; break;
+        case SVM40_I2C_STORE_NVRAM:         op = OP_NVRAM; break;
+        default:                            op = OP_UNKNOWN;
+    }
+
+    if (Command(op, par, len, resp, &rlen) != SVM40_ERR_OK) {
+        _refused++;
+        return;
+    }
+
+    // strings are a zero padded field of 32 bytes (48 bytes with CRC), more
+    // than the Wire buffer, so the driver has to read in parts
+    if (op == OP_TYPE || op == OP_NAME || op == OP_SERIAL)
+        while (rlen < 32) resp[rlen++] = 0;
+
+    // strings are padded with zero to a complete word
+    if (rlen & 1) resp[rlen++] = 0;
+
+    for (i = 0; i < rlen; i += 2) {
+        _out[_outlen++] = resp[i];
+        _out[_outlen++] = resp[i + 1];
+        _out[_outlen++] = I2cCRC(&resp[i]);
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * SVM40 Library host (Linux) build : sensor simulator
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * A simulated SVM40 that answers the UART (SHDLC) and I2C commands the
+ * library uses. It is a Stream, so it can be used directly as serial
+ * port or attached to the host Wire :
+ *
+ *   SVM40_Sim sim(SVM40_SIM_UART);      SVM40_Sim sim(SVM40_SIM_I2C);
+ *   svm40.begin(&sim);                  Wire.attach(&sim);
+ *                                       svm40.begin(&Wire);
+ *
+ * The answer is available immediately after the command was written.
+ * The state (started, temperature offset, tuning parameters, VOC state)
+ * is kept and commands are refused in the wrong state, as the sensor does.
+ *
+ * The measurement values change slowly with every read, or can be set
+ * with SetValues().
+ *
+ * Polling available() while there is nothing to read advances the virtual
+ * clock (host.h) by 1 mS, so a driver timeout takes no real time.
+ *********************************************************************
+ */
+#ifndef SVM40_SIM_H
+#define SVM40_SIM_H
+
+#include "svm40.h"
+
+#define SVM40_SIM_UART  0
+#define SVM40_SIM_I2C   1
+#define SVM40_SIM_BUF   80
+
+class SVM40_Sim : public Stream
+{
+  public:
+
+    SVM40_Sim(uint8_t mode = SVM40_SIM_UART);
+
+    /**
+     * @brief : power-on reset of the simulated sensor
+     */
+    void     Reset();
+
+    /**
+     * @brief : set the values returned by the next reads
+     * @param r : values (NULL = generate values)
+     */
+    void     SetValues(struct svm40_raw *r);
+
+    /**
+     * @brief : number of commands handled / refused
+     */
+    uint32_t GetCommands() {return(_commands);}
+    uint32_t GetRefused()  {return(_refused);}
+
+    bool     IsStarted()   {return(_started);}
+
+    // Stream
+    size_t   write(uint8_t c);
+    size_t   write(const uint8_t *buf, size_t n);
+    int      available();
+    int      read();
+    int      peek();
+
+  private:
+
+    uint8_t  Command(uint16_t cmd, uint8_t *par, uint8_t len, uint8_t *resp, uint8_t *rlen);
+    void     UartFrame();
+    void     UartAnswer(uint8_t cmd, uint8_t state, uint8_t *data, uint8_t len);
+    void     UartAdd(uint8_t c);
+    void     I2cCommand(const uint8_t *buf, size_t n);
+    uint8_t  I2cCRC(const uint8_t *data);
+    void     Values(uint8_t *resp);
+
+    uint8_t  _mode;
+    bool     _started;
+    uint32_t _boot;                 // millis() at reset
+    uint32_t _sample;               // generated samples
+    bool     _fixed;                // use _raw
+    struct svm40_raw _raw;
+    int16_t  _toffset;              // temperature offset (scaled 200)
+    int16_t  _tuning[4];
+    uint8_t  _vocstate[8];
+    uint32_t _commands;
+    uint32_t _refused;
+
+    uint8_t  _in[SVM40_SIM_BUF];    // received UART frame
+    uint8_t  _inlen;
+    bool     _stuff;
+    uint8_t  _out[SVM40_SIM_BUF];   // answer
+    uint8_t  _outlen;
+    uint8_t  _outpos;
+};
+
+#endif /* SVM40_SIM_H */
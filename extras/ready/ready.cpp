@@ -0,0 +1,146 @@
+/**
+ * SVM40 readiness and time budget check on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Checks with the simulated sensor (extras/host/svm40_sim.h) on UART and
+ * I2C that after start() / reset() :
+ *
+ *   - a setting (tuning, offset, VOC state, store) is sent only once the
+ *     sensor is ready
+ *   - with SetBudget() too small, ERR_DEADLINE is returned and nothing
+ *     is sent (a setting during measurement also does not stop it)
+ *   - with SetReadyWait(false), ERR_NOTREADY is returned and nothing is
+ *     sent
+ *
+ * The commands sent are seen with SetTrace(). Exit code 0 if all passed.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src ready.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o ready
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include "host.h"
+#include "svm40_sim.h"
+
+static uint32_t first_tx;           // millis() of the first command sent
+static uint32_t sent;               // commands sent
+static int      failed;
+
+static void trace(void *arg, uint8_t dir, const uint8_t *data, uint8_t len) {
+    (void) arg; (void) data; (void) len;
+
+    if (dir != SVM40_TRACE_TX) return;
+    if (sent++ == 0) first_tx = millis();
+}
+
+static void check(const char *name, bool ok) {
+    printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+    if (! ok) failed++;
+}
+
+// the VOC state can only be set during measurement, the others also idle
+static void restart(SVM40 *s, int which) {
+    if (which == 2) {
+        s->stop();
+        s->start();
+    }
+    else
+        s->reset();
+}
+
+// perform a setting that is sent as the first command
+static uint8_t setting(SVM40 *s, int which) {
+    struct svm_algopar p = {100, 12, 180, 50};
+    uint8_t state[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    switch(which) {
+        case 0:  return(s->SetVocTuningParameters(&p));
+        case 1:  return(s->SetTemperatureOffset(2));
+        case 2:  return(s->SetVocState(state));
+        default: return(s->StoreNvData());
+    }
+}
+
+static void run(uint8_t mode) {
+    const char *what[4] = {"SetVocTuningParameters()", "SetTemperatureOffset()",
+                           "SetVocState()", "StoreNvData()"};
+    const char *tr = mode == SVM40_SIM_UART ? "UART" : "I2C";
+    char name[80];
+    uint32_t ready;
+    uint8_t ret;
+
+    for (int i = 0; i < 4; i++) {
+
+        SVM40_Sim sim(mode);
+        TwoWire wire;
+        SVM40 s;
+
+        if (mode == SVM40_SIM_I2C) {
+            wire.attach(&sim);
+            s.begin(&wire);
+        }
+        else
+            s.begin(&sim);
+
+        s.SetTrace(trace, NULL);
+
+        restart(&s, i);
+
+        // sent when ready
+        ready = millis() + s.GetReadyIn();
+        sent = 0;
+        ret = setting(&s, i);
+        snprintf(name, sizeof(name), "%s %s after %s", tr, what[i], i == 2 ? "start" : "reset");
+        check(name, ret == ERR_OK && sent > 0 && (int32_t) (first_tx - ready) >= 0);
+
+        // too small budget : nothing sent
+        restart(&s, i);
+        s.SetBudget(500);
+        sent = 0;
+        ret = setting(&s, i);
+        snprintf(name, sizeof(name), "%s %s budget", tr, what[i]);
+        check(name, ret == ERR_DEADLINE && sent == 0);
+        s.SetBudget(0);
+
+        // do not wait : nothing sent
+        restart(&s, i);
+        s.SetReadyWait(false);
+        sent = 0;
+        ret = setting(&s, i);
+        snprintf(name, sizeof(name), "%s %s not ready", tr, what[i]);
+        check(name, ret == ERR_NOTREADY && sent == 0);
+    }
+}
+
+int main() {
+    run(SVM40_SIM_UART);
+    run(SVM40_SIM_I2C);
+
+    printf("\n%s\n", failed ? "FAILED" : "all passed");
+    return(failed ? 1 : 0);
+}
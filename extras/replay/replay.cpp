@@ -0,0 +1,442 @@
+/**
+ * SVM40 capture replay
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Replays a capture made with SVM40_Capture (src/svm40_capture.h) through
+ * the driver on Linux at full speed. Each request in the capture is decoded
+ * and the matching driver call is made, the driver gets the answers as
+ * captured. This allows to reproduce a protocol issue from the field with
+ * debug enabled and to benchmark the driver on real traffic.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src replay.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp ../../src/svm40_capture.cpp -o replay
+ *
+ * Usage :
+ *   replay [options] capture
+ *
+ *   -d n      driver debug level (0 - 2, default 0)
+ *   -n n      replay the capture n times (default 1)
+ *   -v        print every call with the result
+ *
+ *   -r        record : create a capture from the simulated sensor
+ *             (extras/host/svm40_sim.h) instead of replay
+ *   -i        record I2C (default UART)
+ *   -c n      record n samples (default 60)
+ *
+ * Output is per driver call : count, errors and average time in uS.
+ * A byte sent by the driver that differs from the capture is counted as
+ * mismatch : the driver did something different than at capture time.
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include "host.h"
+#include "svm40_sim.h"
+#include "svm40_capture.h"
+
+// driver calls that can be replayed
+enum call {
+    C_START, C_STOP, C_RESET, C_VERSION, C_UPTIME, C_VALUES, C_GET_TOFF,
+    C_SET_TOFF, C_GET_TUNING, C_SET_TUNING, C_NVRAM, C_GET_STATE, C_SET_STATE,
+    C_TYPE, C_NAME, C_SERIAL, C_UNKNOWN, C_COUNT
+};
+
+static const char *call_name[C_COUNT] = {
+    "start", "stop", "reset", "GetVersion", "GetSystemUpTime", "GetRawValues",
+    "GetTemperatureOffset", "SetTemperatureOffset", "GetVocTuningParameters",
+    "SetVocTuningParameters", "StoreNvData", "GetVocState", "SetVocState",
+    "GetProductType", "GetProductName", "GetSerialNumber", "unknown (skipped)"
+};
+
+struct call_stat {
+    uint32_t count;
+    uint32_t errors;
+    double   us;
+};
+
+static struct call_stat stats[C_COUNT];
+static int verbose = 0;
+
+/**
+ * @brief : real time in uS
+ */
+static double now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(ts.tv_sec * 1e6 + ts.tv_nsec / 1e3);
+}
+
+/**
+ * @brief : decode a request
+ * @param req : bytes as on the bus
+ * @param len : number of bytes
+ * @param i2c : true if I2C capture
+ * @param par : to store the parameters
+ * @param plen: to store number of parameter bytes
+ *
+ * @return : driver call
+ */
+static uint8_t decode(uint8_t *req, uint8_t len, bool i2c, uint8_t *par, uint8_t *plen) {
+    uint8_t f[SVM40_CAPTURE_MAXREC], flen, i, sub;
+    uint16_t cmd;
+    bool set;
+
+    *plen = 0;
+
+    if (i2c) {
+        if (len < 2) return(C_UNKNOWN);
+
+        cmd = (req[0] << 8) | req[1];
+        for (i = 2; i + 3 <= len; i += 3) {
+            par[(*plen)++] = req[i];
+            par[(*plen)++] = req[i + 1];
+        }
+        set = *plen > 0;
+
+        switch(cmd) {
+            case SVM40_I2C_START_MEASURE:       return(C_START);
+            case SVM40_I2C_STOP_MEASURE:        return(C_STOP);
+            case SVM40_I2C_RESET:               return(C_RESET);
+            case SVM40_I2C_GET_VERSION:         return(C_VERSION);
+            case SVM40_I2C_GET_ID:              return(C_SERIAL);
+            case SVM40_I2C_READ_RESULTS_INT_R:  return(C_VALUES);
+            case SVM40_I2C_GET_TEMP_OFFSET:     return(set ? C_SET_TOFF : C_GET_TOFF);
+            case SVM40_I2C_GET_VOC_STATE:       return(set ? C_SET_STATE : C_GET_STATE);
+            case SVM40_I2C_GET_VOC_TUNING:      return(set ? C_SET_TUNING : C_GET_TUNING);
+            case SVM40_I2C_STORE_NVRAM:         return(C_NVRAM);
+            default:                            return(C_UNKNOWN);
+        }
+    }
+
+    // UART : unstuff 0x7E addr cmd len data... crc 0x7E
+    for (i = 1, flen = 0; i < len && req[i] != SHDLC_IND; i++) {
+        if (req[i] == 0x7D && i + 1 < len) f[flen++] = req[++i] ^ 0x20;
+        else f[flen++] = req[i];
+    }
+
+    if (len < 2 || req[0] != SHDLC_IND || flen < 4) return(C_UNKNOWN);
+
+    sub = f[2] > 0 ? f[3] : 0xff;
+    for (i = 4; i < flen - 1; i++) par[(*plen)++] = f[i];
+
+    switch(f[1]) {
+        case SVM40_SHDLC_START_MEASURE:     return(C_START);
+        case SVM40_SHDLC_STOP_MEASURE:      return(C_STOP);
+        case SVM40_SHDLC_RESET:             return(C_RESET);
+        case SVM40_SHDLC_GET_VERSION:       return(C_VERSION);
+        case SVM40_SHDLC_SYSTEM_UPTIME:     return(C_UPTIME);
+
+        case SVM40_SHDLC_READ_BASE:
+            if (sub == SVM40_SHDLC_READ_RESULTS_INT_RAW) return(C_VALUES);
+            break;
+
+        case SVM40_SHDLC_BASELINE_ALG:
+            if (sub == SVM40_SHDLC_GET_TEMP_OFFSET) return(C_GET_TOFF);
+            if (sub == SVM40_SHDLC_SET_TEMP_OFFSET) return(C_SET_TOFF);
+            if (sub == SVM40_SHDLC_GET_VOC_TUNING) return(C_GET_TUNING);
+            if (sub == SVM40_SHDLC_SET_VOC_TUNING) return(C_SET_TUNING);
+            if (sub == SVM40_SHDLC_STORE_NVRAM) return(C_NVRAM);
+            break;
+
+        case SVM40_SHDLC_BASELINE_STATE:
+            if (sub == SVM40_SHDLC_GET_VOC_STATE) return(C_GET_STATE);
+            if (sub == SVM40_SHDLC_SET_VOC_STATE) return(C_SET_STATE);
+            break;
+
+        case SVM40_SHDLC_GET_DEVICE_INFO:
+            if (sub == SVM40_SHDLC_DEVICE_PRODUCT_TYPE) return(C_TYPE);
+            if (sub == SVM40_SHDLC_DEVICE_PRODUCT_NAME) return(C_NAME);
+            if (sub == SVM40_SHDLC_DEVICE_SERIAL) return(C_SERIAL);
+            break;
+    }
+
+    return(C_UNKNOWN);
+}
+
+/**
+ * @brief : perform the driver call
+ *
+ * @return : ERR_OK or error
+ */
+static uint8_t perform(SVM40 *svm, uint8_t c, uint8_t *par, uint8_t plen) {
+    SVM40_version ver;
+    struct svm40_raw r;
+    struct svm_algopar tun;
+    uint32_t up;
+    int16_t off;
+    uint8_t state[8], ret = ERR_OK;
+    char buf[MAXRECVBUFLENGTH];
+
+    switch(c) {
+        case C_START:   ret = svm->start() ? ERR_OK : ERR_CMDSTATE; break;
+        case C_STOP:    ret = svm->stop() ? ERR_OK : ERR_CMDSTATE; break;
+        case C_RESET:   ret = svm->reset() ? ERR_OK : ERR_CMDSTATE; break;
+
+        case C_VERSION:
+            ret = svm->GetVersion(&ver);
+            if (verbose) (printf)(" FW %d.%d HW %d.%d", ver.major, ver.minor, ver.HW_major, ver.HW_minor);
+            break;
+
+        case C_UPTIME:
+            ret = svm->GetSystemUpTime(&up);
+            if (verbose) (printf)(" %u s", up);
+            break;
+
+        case C_VALUES:
+            ret = svm->GetRawValues(&r);
+            if (verbose) (printf)(" VOC %u T %d RH %d ticks %u", r.VOC_index, r.temperature,
+                                 r.humidity, r.raw_voc_ticks);
+            break;
+
+        case C_GET_TOFF:
+            ret = svm->GetTemperatureOffset(&off);
+            if (verbose) (printf)(" %d", off);
+            break;
+
+        case C_SET_TOFF:
+            off = plen >= 2 ? (int16_t) ((par[0] << 8) | par[1]) / 200 : 0;
+            ret = svm->SetTemperatureOffset(off);
+            break;
+
+        case C_GET_TUNING:
+            ret = svm->GetVocTuningParameters(&tun);
+            if (verbose) (printf)(" %d %d %d %d", tun.voc_index_offset, tun.learning_time_hours,
+                                 tun.gating_max_duration_minutes, tun.std_initial);
+            break;
+
+        case C_SET_TUNING:
+            tun.voc_index_offset = 100;
+            tun.learning_time_hours = 12;
+            tun.gating_max_duration_minutes = 180;
+            tun.std_initial = 50;
+            if (plen >= 8) {
+                tun.voc_index_offset = (par[0] << 8) | par[1];
+                tun.learning_time_hours = (par[2] << 8) | par[3];
+                tun.gating_max_duration_minutes = (par[4] << 8) | par[5];
+                tun.std_initial = (par[6] << 8) | par[7];
+            }
+            ret = svm->SetVocTuningParameters(&tun);
+            break;
+
+        case C_NVRAM:
+            ret = svm->StoreNvData();
+            break;
+
+        case C_GET_STATE:
+            ret = svm->GetVocState(state);
+            break;
+
+        case C_SET_STATE:
+            memset(state, 0, sizeof(state));
+            memcpy(state, par, plen < 8 ? plen : 8);
+            ret = svm->SetVocState(state);
+            break;
+
+        case C_TYPE:
+        case C_NAME:
+        case C_SERIAL:
+            memset(buf, 0, sizeof(buf));
+            if (c == C_TYPE) ret = svm->GetProductType(buf, sizeof(buf) - 1);
+            else if (c == C_NAME) ret = svm->GetProductName(buf, sizeof(buf) - 1);
+            else ret = svm->GetSerialNumber(buf, sizeof(buf) - 1);
+            if (verbose) (printf)(" %s", buf);
+            break;
+    }
+
+    return(ret);
+}
+
+/**
+ * @brief : replay a capture once
+ *
+ * @return : bytes that differ from the capture, -1 on error
+ */
+static long replay(const char *name, int debug) {
+    FileStream f;
+    SVM40_Replay rep;
+    SVM40 svm;
+    uint8_t req[SVM40_CAPTURE_MAXREC], par[SVM40_CAPTURE_MAXREC];
+    uint8_t len, plen, c, ret;
+    bool i2c;
+    double start;
+
+    if (! f.open(name, "rb")) {
+        fprintf(stderr, "can not open %s\n", name);
+        return(-1);
+    }
+
+    if (! rep.begin(&f)) {
+        fprintf(stderr, "%s is not a capture\n", name);
+        return(-1);
+    }
+
+    i2c = rep.GetTransport() == SVM40_CAPTURE_I2C;
+
+    if (i2c) {
+        Wire.begin();
+        Wire.attach(&rep);
+        svm.begin(&Wire);
+    }
+    else
+        svm.begin(&rep);
+
+    svm.EnableDebugging(debug);
+
+    while ((len = rep.PeekRequest(req)) > 0) {
+
+        c = decode(req, len, i2c, par, &plen);
+
+        // not a driver call : skip request (the answer is skipped on next write)
+        if (c == C_UNKNOWN) {
+            rep.write(req, len);
+            stats[c].count++;
+            continue;
+        }
+
+        if (verbose) (printf)("%s", call_name[c]);
+
+        start = now_us();
+        ret = perform(&svm, c, par, plen);
+        stats[c].us += now_us() - start;
+        stats[c].count++;
+
+        if (ret != ERR_OK) stats[c].errors++;
+
+        if (verbose) (printf)(" : 0x%02X\n", ret);
+    }
+
+    return(rep.GetMismatch());
+}
+
+/**
+ * @brief : create a capture with the simulated sensor
+ */
+static int record(const char *name, bool i2c, int samples) {
+    FileStream f;
+    SVM40_Capture cap;
+    SVM40_Sim sim(i2c ? SVM40_SIM_I2C : SVM40_SIM_UART);
+    SVM40 svm;
+    SVM40_version ver;
+    struct svm40_raw r;
+    struct svm_algopar tun;
+    uint32_t up;
+    int16_t off;
+    uint8_t state[8];
+    char buf[32];
+    int i;
+
+    if (! f.open(name, "wb")) {
+        fprintf(stderr, "can not create %s\n", name);
+        return(1);
+    }
+
+    if (i2c) {
+        Wire.begin();
+        Wire.attach(&sim);
+        svm.begin(&Wire);
+    }
+    else
+        svm.begin(&sim);
+
+    cap.begin(&svm, &f, i2c ? SVM40_CAPTURE_I2C : SVM40_CAPTURE_UART);
+
+    svm.GetVersion(&ver);
+    svm.GetSerialNumber(buf, sizeof(buf));
+    svm.GetProductName(buf, sizeof(buf));
+    svm.GetTemperatureOffset(&off);
+    svm.SetTemperatureOffset(2);
+    svm.GetVocTuningParameters(&tun);
+
+    for (i = 0; i < samples; i++) {
+        svm.GetRawValues(&r);
+        delay(1000);
+    }
+
+    svm.GetSystemUpTime(&up);
+    svm.GetVocState(state);
+    svm.stop();
+
+    cap.end();
+
+    (printf)("%s : %u bytes, %d samples\n", name, cap.GetBytes(), samples);
+    return(0);
+}
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-d n] [-n n] [-v] capture\n", name);
+    fprintf(stderr, "        %s -r [-i] [-c n] capture\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    int opt, debug = 0, loops = 1, samples = 60, i;
+    bool rec = false, i2c = false;
+    long mismatch = 0, m;
+    uint32_t calls = 0, errors = 0;
+    double us = 0;
+
+    while ((opt = getopt(argc, argv, "d:n:vric:")) != -1) {
+        switch(opt) {
+            case 'd': debug = atoi(optarg); break;
+            case 'n': loops = atoi(optarg); break;
+            case 'v': verbose = 1; break;
+            case 'r': rec = true; break;
+            case 'i': i2c = true; break;
+            case 'c': samples = atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (optind != argc - 1) usage(argv[0]);
+
+    if (rec) return(record(argv[optind], i2c, samples));
+
+    for (i = 0; i < loops; i++) {
+        m = replay(argv[optind], debug);
+        if (m < 0) return(1);
+        mismatch += m;
+    }
+
+    (printf)("%-24s %8s %8s %10s\n", "call", "count", "errors", "avg uS");
+
+    for (i = 0; i < C_COUNT; i++) {
+        if (stats[i].count == 0) continue;
+        (printf)("%-24s %8u %8u %10.2f\n", call_name[i], stats[i].count, stats[i].errors,
+                 stats[i].us / stats[i].count);
+        calls += stats[i].count;
+        errors += stats[i].errors;
+        us += stats[i].us;
+    }
+
+    (printf)("\ncalls %u, errors %u, mismatch bytes %ld, %.1f mS, virtual time skipped %lu mS\n",
+             calls, errors, mismatch, us / 1000, host_skipped());
+
+    return(mismatch > 0 || errors > 0 ? 2 : 0);
+}
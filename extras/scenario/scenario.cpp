@@ -0,0 +1,364 @@
+/**
+ * SVM40 end-to-end throughput benchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ * - added threads (-t) and shared instances (-S)
+ *
+ * How many SVM40 sensors can one core service? This reads N simulated
+ * sensors (extras/host/svm40_sim.h), a mix of UART and I2C, each once per
+ * period with the driver on a single thread, and reports :
+ *
+ *   rate    : samples per second achieved (N per second is needed)
+ *   cpu     : CPU time per sample (driver and simulator) in uS
+ *   p50 .. max : latency from the moment a sample is due until it is
+ *                obtained, in mS (max 100000)
+ *   late    : % of samples obtained after the next one was due
+ *   skipped : % of samples never read as the driver was too late
+ *
+ * By default the time is virtual (see extras/host/host.h) so a simulated
+ * day takes seconds. The driver waits after each command (RX_DELAY_MS),
+ * in virtual time this is counted as time used but not as CPU time.
+ *
+ * With -t the sensors are divided over threads, each thread drives its own
+ * sensors (and has its own virtual clock). With -S every thread reads every
+ * sensor, at random, as fast as it can. The instances are then shared and
+ * protected with SetLock(). Build with -fsanitize=thread to check there
+ * are no data races :
+ *
+ *   g++ -O1 -g -fsanitize=thread -I../host -I../../src scenario.cpp ../host/host.cpp \
+ *       ../host/svm40_sim.cpp ../../src/svm40.cpp ../../src/svm40_bus.cpp -o scenario -lpthread
+ *   ./scenario -n 16 -t 4 -d 3600
+ *   ./scenario -n 4 -t 8 -S -d 60
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src scenario.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o scenario -lpthread
+ *
+ * Usage :
+ *   scenario [options]
+ *
+ *   -n list   number of sensors, comma separated (default 1,5,10,50,100,500)
+ *   -u pct    % of sensors on UART, rest is I2C (default 50)
+ *   -d sec    duration in seconds (default 86400 = 1 day)
+ *   -p mS     period per sensor (default 1000)
+ *   -r        real time : delays are real and the duration is real
+ *   -t num    number of threads (default 1)
+ *   -S        shared : all threads read all sensors (at random)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <thread>
+#include <mutex>
+#include "host.h"
+#include "svm40_sim.h"
+
+#define LAT_MAX 100000          // latency histogram (mS)
+
+struct device {
+    SVM40     svm;
+    SVM40_Sim *sim;
+    TwoWire   *wire;
+    uint32_t  next;             // millis() next sample is due
+    std::recursive_mutex lock;  // shared mode (-S)
+};
+
+struct result {
+    uint32_t  uart;
+    uint32_t  samples;
+    uint32_t  errors;
+    uint32_t  late;
+    uint32_t  skipped;
+    double    cpu;              // seconds
+    uint32_t  lat[LAT_MAX + 1]; // latency histogram
+};
+
+static double cpu_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return(ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * @brief : latency in mS at the requested fraction
+ */
+static uint32_t percentile(struct result *r, double frac) {
+    uint64_t need, sum = 0;
+    uint32_t i;
+
+    need = (uint64_t) (r->samples * frac);
+    if (need == 0) need = 1;
+
+    for (i = 0; i <= LAT_MAX; i++) {
+        sum += r->lat[i];
+        if (sum >= need) return(i);
+    }
+    return(LAT_MAX);
+}
+
+/**
+ * @brief : lock hook for SetLock()
+ */
+static void dev_lock(void *arg, bool lock) {
+    std::recursive_mutex *m = (std::recursive_mutex *) arg;
+    if (lock) m->lock();
+    else m->unlock();
+}
+
+/**
+ * @brief : create the simulated sensor and connect the driver
+ * @param d    : device
+ * @param uart : true = UART, false = I2C
+ */
+static void dev_init(struct device *d, bool uart) {
+    if (uart) {
+        d->sim = new SVM40_Sim(SVM40_SIM_UART);
+        d->wire = NULL;
+        d->svm.begin(d->sim);
+    }
+    else {
+        d->sim = new SVM40_Sim(SVM40_SIM_I2C);
+        d->wire = new TwoWire();
+        d->wire->attach(d->sim);
+        d->svm.begin(d->wire);
+    }
+}
+
+/**
+ * @brief : read the sensors of one thread on schedule
+ * @param dev      : all sensors
+ * @param n        : number of sensors
+ * @param first    : first sensor of this thread
+ * @param step     : number of threads
+ * @param duration : in seconds
+ * @param period   : mS between samples of a sensor
+ * @param r        : to store result
+ */
+static void run_thread(struct device *dev, uint32_t n, uint32_t first, uint32_t step,
+                       uint32_t duration, uint32_t period, struct result *r) {
+    struct svm40_values v;
+    uint32_t i, start, end, now, done, lat, wait;
+    bool busy;
+
+    start = millis();
+
+    // spread the sensors over the period
+    for (i = first; i < n; i += step) dev[i].next = start + (uint64_t) i * period / n;
+
+    end = start + duration * 1000;
+
+    while ((int32_t) (millis() - end) < 0) {
+
+        busy = false;
+        wait = period;
+
+        for (i = first; i < n; i += step) {
+
+            now = millis();
+
+            if ((int32_t) (now - dev[i].next) >= 0) {
+
+                if (dev[i].svm.GetValues(&v) != ERR_OK) r->errors++;
+                r->samples++;
+                busy = true;
+
+                done = millis();
+                lat = done - dev[i].next;
+                r->lat[lat > LAT_MAX ? LAT_MAX : lat]++;
+
+                dev[i].next += period;
+
+                if ((int32_t) (done - dev[i].next) >= 0) r->late++;
+
+                // samples that are no longer useful
+                while ((int32_t) (done - dev[i].next - period) >= 0) {
+                    dev[i].next += period;
+                    r->skipped++;
+                }
+
+                now = done;
+            }
+
+            if ((int32_t) (dev[i].next - now) > 0 && dev[i].next - now < wait) wait = dev[i].next - now;
+        }
+
+        if (! busy) delay(wait);
+    }
+}
+
+/**
+ * @brief : read random sensors as fast as possible (shared mode)
+ * @param dev      : all sensors
+ * @param n        : number of sensors
+ * @param seed     : for random selection
+ * @param duration : in seconds
+ * @param r        : to store result
+ */
+static void run_shared(struct device *dev, uint32_t n, uint32_t seed, uint32_t duration, struct result *r) {
+    struct svm40_values v;
+    uint32_t i, start, end, lat;
+
+    start = millis();
+    end = start + duration * 1000;
+
+    while ((int32_t) (millis() - end) < 0) {
+
+        // xorshift32
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        i = seed % n;
+
+        start = millis();
+        if (dev[i].svm.GetValues(&v) != ERR_OK) r->errors++;
+        r->samples++;
+
+        lat = millis() - start;
+        r->lat[lat > LAT_MAX ? LAT_MAX : lat]++;
+    }
+}
+
+/**
+ * @brief : run the scenario
+ * @param n        : number of sensors
+ * @param uart_pct : % on UART
+ * @param duration : in seconds
+ * @param period   : mS between samples of a sensor
+ * @param threads  : number of threads
+ * @param shared   : all threads read all sensors
+ * @param r        : to store result
+ */
+static void run(uint32_t n, uint32_t uart_pct, uint32_t duration, uint32_t period,
+                uint32_t threads, bool shared, struct result *r) {
+    struct device *dev = new struct device[n];
+    struct result *tr = new struct result[threads];
+    std::thread *th = new std::thread[threads];
+    uint32_t i, t;
+    double c;
+
+    memset(r, 0, sizeof(struct result));
+    memset(tr, 0, threads * sizeof(struct result));
+
+    for (i = 0; i < n; i++) {
+
+        // spread UART over the sensors
+        if ((i * uart_pct) / 100 != ((i + 1) * uart_pct) / 100) {
+            dev_init(&dev[i], true);
+            r->uart++;
+        }
+        else
+            dev_init(&dev[i], false);
+
+        if (shared) dev[i].svm.SetLock(dev_lock, &dev[i].lock);
+    }
+
+    c = cpu_s();
+
+    for (t = 0; t < threads; t++) {
+        if (shared)
+            th[t] = std::thread(run_shared, dev, n, 0x9e3779b9 * (t + 1), duration, &tr[t]);
+        else
+            th[t] = std::thread(run_thread, dev, n, t, threads, duration, period, &tr[t]);
+    }
+
+    for (t = 0; t < threads; t++) {
+        th[t].join();
+
+        r->samples += tr[t].samples;
+        r->errors += tr[t].errors;
+        r->late += tr[t].late;
+        r->skipped += tr[t].skipped;
+        for (i = 0; i <= LAT_MAX; i++) r->lat[i] += tr[t].lat[i];
+    }
+
+    r->cpu = cpu_s() - c;
+
+    for (i = 0; i < n; i++) {
+        delete dev[i].sim;
+        delete dev[i].wire;
+    }
+    delete [] th;
+    delete [] tr;
+    delete [] dev;
+}
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-n list] [-u pct] [-d sec] [-p mS] [-r] [-t num] [-S]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    static struct result r;
+    const char *list = "1,5,10,50,100,500";
+    char *p;
+    uint32_t n, uart_pct = 50, duration = 86400, period = 1000, threads = 1, want;
+    bool realtime = false, shared = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:u:d:p:rt:S")) != -1) {
+        switch(opt) {
+            case 'n': list = optarg; break;
+            case 'u': uart_pct = atoi(optarg); break;
+            case 'd': duration = atoi(optarg); break;
+            case 'p': period = atoi(optarg); break;
+            case 'r': realtime = true; break;
+            case 't': threads = atoi(optarg); break;
+            case 'S': shared = true; break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (uart_pct > 100 || period == 0 || duration == 0 || threads == 0) usage(argv[0]);
+
+    host_realtime(realtime);
+
+    (printf)("%u seconds, period %u mS, %s time, %u thread(s)%s\n\n", duration, period,
+             realtime ? "real" : "virtual", threads, shared ? ", shared" : "");
+    (printf)("%6s %5s %5s %10s %9s %8s %7s %7s %7s %7s %7s %7s %7s\n", "N", "uart", "i2c",
+             "samples", "rate/s", "cpu uS", "p50", "p99", "p99.9", "max", "late%", "skip%", "errors");
+
+    for (p = (char *) list; *p; ) {
+
+        n = strtoul(p, &p, 10);
+        if (*p == ',') p++;
+        if (n == 0) continue;
+
+        run(n, uart_pct, duration, period, threads, shared, &r);
+
+        want = r.samples + r.skipped;
+
+        (printf)("%6u %5u %5u %10u %9.2f %8.2f %7u %7u %7u %7u %7.2f %7.2f %7u\n",
+                 n, r.uart, n - r.uart, r.samples, (double) r.samples / duration,
+                 r.samples ? r.cpu * 1e6 / r.samples : 0,
+                 percentile(&r, 0.5), percentile(&r, 0.99), percentile(&r, 0.999),
+                 percentile(&r, 1.0), want ? 100.0 * r.late / want : 0,
+                 want ? 100.0 * r.skipped / want : 0, r.errors);
+    }
+
+    return(0);
+}
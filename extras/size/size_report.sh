@@ -0,0 +1,91 @@
+#!/bin/bash
+#
+# SVM40 library flash / RAM footprint report
+#
+# paulvha / October 2026 / version 1.0
+#
+# Builds extras/size/size_sketch with arduino-cli for each build option
+# of the library and shows text / data / bss of the result. The sketch
+# itself is small, so differences between the options are due to the
+# library.
+#
+# Needs arduino-cli with the cores of the boards installed, e.g.
+#   arduino-cli core install arduino:avr arduino:samd
+#
+# Usage :
+#   ./size_report.sh [fqbn ...]
+#
+#   default boards : arduino:avr:uno (AVR) and arduino:samd:mkrzero (ARM)
+#
+# The minimal I2C profile on the UNO is checked against a budget, set
+# BUDGET_FLASH / BUDGET_RAM (bytes) to change. Exit code is 1 if over.
+
+BUDGET_FLASH=${BUDGET_FLASH:-16384}     # half of the UNO flash
+BUDGET_RAM=${BUDGET_RAM:-512}           # a quarter of the UNO RAM
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+LIB=$(cd "$DIR/../.." && pwd)
+SKETCH=$DIR/size_sketch
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+BOARDS=${*:-"arduino:avr:uno arduino:samd:mkrzero"}
+
+# name|build flags
+CONFIGS=(
+    "both|"
+    "i2c-only|-DSVM40_NO_UART"
+    "uart-only|-DSVM40_NO_I2C"
+    "both-nodebug|-DSVM40_NO_DEBUG"
+    "minimal|-DSVM40_MINIMAL"
+    "minimal-i2c|-DSVM40_MINIMAL -DSVM40_NO_UART"
+)
+
+if ! command -v arduino-cli > /dev/null; then
+    echo "arduino-cli not found"
+    exit 2
+fi
+
+# size tool of the toolchain that was used for the build
+size_tool() {
+    local t
+    t=$(find "$HOME/.arduino15/packages" -type f \( -name avr-size -o -name arm-none-eabi-size \) 2>/dev/null | grep "$1" | head -1)
+    echo "${t:-size}"
+}
+
+over=0
+
+printf "%-22s %-14s %8s %8s %8s %8s %8s\n" board config text data bss flash ram
+
+for b in $BOARDS; do
+    case $b in
+        *avr*) tool=$(size_tool avr-size) ;;
+        *)     tool=$(size_tool arm-none-eabi-size) ;;
+    esac
+
+    for c in "${CONFIGS[@]}"; do
+        name=${c%%|*}
+        flags=${c#*|}
+        out=$TMP/$(echo "$b" | tr ':' '_')-$name
+
+        if ! arduino-cli compile -b "$b" --library "$LIB" --build-path "$out" \
+             --build-property "compiler.cpp.extra_flags=$flags" "$SKETCH" > "$out.log" 2>&1; then
+            printf "%-22s %-14s build failed (%s)\n" "$b" "$name" "$out.log"
+            continue
+        fi
+
+        read -r text data bss < <("$tool" "$out"/size_sketch.ino.elf | awk 'NR==2 {print $1, $2, $3}')
+
+        printf "%-22s %-14s %8d %8d %8d %8d %8d\n" "$b" "$name" "$text" "$data" "$bss" \
+               $((text + data)) $((data + bss))
+
+        if [ "$b" = "arduino:avr:uno" ] && [ "$name" = "minimal-i2c" ]; then
+            if [ $((text + data)) -gt "$BUDGET_FLASH" ] || [ $((data + bss)) -gt "$BUDGET_RAM" ]; then
+                echo "  over budget : flash $BUDGET_FLASH, ram $BUDGET_RAM"
+                over=1
+            fi
+        fi
+    done
+done
+
+exit $over
@@ -0,0 +1,34 @@
+/*  Sketch used by size_report.sh to measure the library footprint.
+ *
+ *  Not for use on a board : the build flags (SVM40_NO_UART etc.) are
+ *  set by size_report.sh.
+ *
+ *  paulvha / October 2026
+ */
+#include "svm40.h"
+
+SVM40 mySVM40;
+
+void setup() {
+
+#if defined SVM40_NO_UART
+  Wire.begin();
+  mySVM40.begin(&Wire);
+#else
+  Serial.begin(115200);
+  mySVM40.begin(&Serial);
+#endif
+
+  mySVM40.EnableDebugging(1);
+  mySVM40.probe();
+}
+
+void loop() {
+  struct svm40_values v;
+
+  if (mySVM40.GetValues(&v) == ERR_OK) {
+    Serial.println(v.temperature);
+  }
+
+  delay(1000);
+}
@@ -0,0 +1,95 @@
+/**
+ * SVM40 UART byte stuffing check on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Checks with the simulated sensor (extras/host/svm40_sim.h) on UART that
+ * data with the special bytes 0x7E, 0x7D, 0x11 and 0x13 is byte stuffed :
+ *
+ *   - a VOC state and tuning parameters with these bytes are written and
+ *     read back unchanged
+ *   - no frame sent has one of these bytes between the start and stop
+ *     byte (seen with SetTrace())
+ *
+ * Exit code 0 if all passed.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src stuffing.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o stuffing
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "svm40_sim.h"
+
+static bool raw_special;            // a special byte was sent unstuffed
+static int  failed;
+
+static void trace(void *arg, uint8_t dir, const uint8_t *data, uint8_t len) {
+    (void) arg;
+
+    if (dir != SVM40_TRACE_TX) return;
+
+    for (uint8_t i = 1; i + 1 < len; i++) {
+        if (data[i] == 0x7E || data[i] == 0x11 || data[i] == 0x13) raw_special = true;
+    }
+}
+
+static void check(const char *name, bool ok) {
+    printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+    if (! ok) failed++;
+}
+
+int main() {
+    uint8_t state[8] = {0x7E, 0x7D, 0x11, 0x13, 0x7E, 0x7E, 0x00, 0x7D}, rd[8];
+    struct svm_algopar p = {0x7E, 0x11, 0x13, 0x7D}, q;
+    uint8_t ret;
+
+    SVM40_Sim sim(SVM40_SIM_UART);
+    SVM40 s;
+
+    s.begin(&sim);
+    s.SetTrace(trace, NULL);
+    s.start();
+
+    ret = s.SetVocTuningParameters(&p);
+    check("UART SetVocTuningParameters()", ret == ERR_OK);
+
+    ret = s.GetVocTuningParameters(&q);
+    check("UART tuning read back", ret == ERR_OK && memcmp(&p, &q, sizeof(p)) == 0);
+
+    ret = s.SetVocState(state);
+    check("UART SetVocState()", ret == ERR_OK);
+
+    ret = s.GetVocState(rd);
+    check("UART VOC state read back", ret == ERR_OK && memcmp(state, rd, sizeof(rd)) == 0);
+
+    check("UART no special byte sent unstuffed", ! raw_special);
+
+    printf("\n%s\n", failed ? "FAILED" : "all passed");
+    return(failed ? 1 : 0);
+}
@@ -0,0 +1,101 @@
+/**
+ * SVM40 configuration sync check on the host
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Checks with the simulated sensor (extras/host/svm40_sim.h) on UART and
+ * I2C that syncConfig() writes only what differs :
+ *
+ *   - the first sync writes the offset and tuning and stores them
+ *   - the offset reads back as written (also negative)
+ *   - a second sync of the same configuration writes nothing
+ *
+ * Exit code 0 if all passed.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src sync.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o sync
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+#include "svm40_sim.h"
+
+static int failed;
+
+static void check(const char *name, bool ok) {
+    printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+    if (! ok) failed++;
+}
+
+static void run(uint8_t mode, int16_t toff) {
+    const char *tr = mode == SVM40_SIM_UART ? "UART" : "I2C";
+    struct svm40_config c;
+    struct svm_algopar p = {150, 24, 60, 40};
+    char name[80];
+    uint8_t report, ret;
+    int16_t off;
+
+    SVM40_Sim sim(mode);
+    TwoWire wire;
+    SVM40 s;
+
+    if (mode == SVM40_SIM_I2C) {
+        wire.attach(&sim);
+        s.begin(&wire);
+    }
+    else
+        s.begin(&sim);
+
+    memset(&c, 0, sizeof(c));
+    c.flags = SVM40_CFG_OFFSET | SVM40_CFG_TUNING;
+    c.temp_offset = toff;
+    c.tuning = p;
+    s.SealConfig(&c);
+
+    ret = s.syncConfig(&c, &report);
+    snprintf(name, sizeof(name), "%s offset %d first sync", tr, toff);
+    check(name, ret == ERR_OK && report == (SVM40_CFG_OFFSET | SVM40_CFG_TUNING | SVM40_SYNC_STORED));
+
+    ret = s.GetTemperatureOffset(&off);
+    snprintf(name, sizeof(name), "%s offset %d read back", tr, toff);
+    check(name, ret == ERR_OK && off == toff);
+
+    ret = s.syncConfig(&c, &report);
+    snprintf(name, sizeof(name), "%s offset %d second sync", tr, toff);
+    check(name, ret == ERR_OK && report == 0);
+}
+
+int main() {
+    run(SVM40_SIM_UART, 2);
+    run(SVM40_SIM_UART, -2);
+    run(SVM40_SIM_I2C, 2);
+    run(SVM40_SIM_I2C, -2);
+
+    printf("\n%s\n", failed ? "FAILED" : "all passed");
+    return(failed ? 1 : 0);
+}
@@ -0,0 +1,350 @@
+/**
+ * SVM40 VOC tuning parameter sweep
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Replays recorded raw VOC ticks through the VOC index algorithm
+ * (src/svm40_voc_algorithm.cpp) for a grid of tuning parameters and
+ * reports per parameter set how the VOC index behaves. This helps to
+ * select svm_algopar values for SetVocTuningParameters() without waiting
+ * hours on a live sensor.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -std=c++11 -pthread -I../../src voc_sweep.cpp ../../src/svm40_voc_algorithm.cpp -o voc_sweep
+ *
+ * Usage :
+ *   voc_sweep [options] recording [recording ...]
+ *
+ *   -o list   voc_index_offset            (default 100)
+ *   -l list   learning_time_hours         (default 12)
+ *   -g list   gating_max_duration_minutes (default 180)
+ *   -s list   std_initial                 (default 50)
+ *   -j n      number of threads           (default all cores)
+ *   -v        also print a line per parameter set and recording
+ *
+ *   A list is comma separated values and/or ranges first:last:step
+ *   e.g. -o 50:200:50,250  -l 6,12,24
+ *
+ * A recording is a text file with a sample (1 per second) on each line :
+ *   raw_voc_ticks[,VOC_index]
+ * The optional VOC index is the value the sensor reported. If available,
+ * the difference with the calculated index is reported (mae / rmse).
+ * NOTE : the port of the algorithm has not yet been compared with the
+ * index of a real sensor. A small mae / rmse against a real recording is
+ * the check that the host result matches the sensor.
+ * Empty lines and lines not starting with a digit are skipped.
+ *
+ * Output is CSV on stdout, a line per parameter set with the average over
+ * all recordings :
+ *   offset,learning,gating,std,samples,mean,stddev,max,above150,above250,mae,rmse
+ *   above150 / above250 : % of time the VOC index was above this level.
+ *
+ * All parameter sets x recordings are put in one list and each thread
+ * takes the next item from the list, so a long recording does not hold
+ * up the other threads.
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include "svm40_voc_algorithm.h"
+
+// samples to skip before comparing (algorithm blackout)
+#define BLACKOUT 45
+
+struct recording {
+    std::string          name;
+    std::vector<int32_t> raw;
+    std::vector<int16_t> ref;      // sensor VOC index (-1 = not available)
+    bool                 has_ref;
+};
+
+struct parset {
+    int16_t offset;
+    int16_t learning;
+    int16_t gating;
+    int16_t std_initial;
+};
+
+struct result {
+    uint32_t samples;
+    double   mean;
+    double   stddev;
+    int32_t  max;
+    double   above150;              // % of samples
+    double   above250;
+    double   mae;                   // -1 if no reference
+    double   rmse;
+};
+
+static std::vector<recording> recs;
+static std::vector<parset>    sets;
+static std::vector<result>    results;       // sets x recordings
+static std::atomic<size_t>    next_item(0);
+
+/**
+ * @brief : read a recording
+ *
+ * @return : true if OK
+ */
+static bool read_recording(const char *name, recording *r) {
+    char line[128];
+    char *p;
+    long raw, ref;
+    FILE *fp = fopen(name, "r");
+
+    if (fp == NULL) {
+        fprintf(stderr, "can not open %s\n", name);
+        return(false);
+    }
+
+    r->name = name;
+    r->has_ref = false;
+
+    while (fgets(line, sizeof(line), fp)) {
+
+        if (line[0] < '0' || line[0] > '9') continue;
+
+        raw = strtol(line, &p, 10);
+        ref = -1;
+
+        if (*p == ',' || *p == ';' || *p == '\t' || *p == ' ') {
+            ref = strtol(p + 1, &p, 10);
+            r->has_ref = true;
+        }
+
+        r->raw.push_back((int32_t) raw);
+        r->ref.push_back((int16_t) ref);
+    }
+
+    fclose(fp);
+
+    if (r->raw.size() == 0) {
+        fprintf(stderr, "no samples in %s\n", name);
+        return(false);
+    }
+
+    return(true);
+}
+
+/**
+ * @brief : parse a list like 50:200:50,250
+ *
+ * @return : true if OK
+ */
+static bool parse_list(const char *arg, std::vector<int16_t> *list) {
+    long first, last, step;
+    char *p = (char *) arg;
+
+    list->clear();
+
+    while (*p) {
+        first = strtol(p, &p, 10);
+        last = first;
+        step = 1;
+
+        if (*p == ':') {
+            last = strtol(p + 1, &p, 10);
+            if (*p == ':') step = strtol(p + 1, &p, 10);
+            if (step <= 0) return(false);
+        }
+
+        for (long v = first; v <= last; v += step) list->push_back((int16_t) v);
+
+        if (*p == ',') p++;
+        else if (*p) return(false);
+    }
+
+    return(list->size() > 0);
+}
+
+/**
+ * @brief : replay one recording with one parameter set
+ */
+static void run_item(const parset *ps, const recording *r, result *res) {
+    SVM40_VocAlgorithm algo;
+    double sum = 0, sum2 = 0, err = 0, err2 = 0;
+    uint32_t above150 = 0, above250 = 0, n = 0, nref = 0;
+    int32_t idx, max = 0;
+    size_t i;
+
+    algo.SetTuningParameters(ps->offset, ps->learning, ps->gating, ps->std_initial);
+
+    for (i = 0; i < r->raw.size(); i++) {
+
+        idx = algo.Process(r->raw[i]);
+
+        if (i < BLACKOUT) continue;
+
+        n++;
+        sum += idx;
+        sum2 += (double) idx * idx;
+        if (idx > max) max = idx;
+        if (idx > 150) above150++;
+        if (idx > 250) above250++;
+
+        if (r->ref[i] >= 0) {
+            double d = idx - r->ref[i];
+            err += fabs(d);
+            err2 += d * d;
+            nref++;
+        }
+    }
+
+    res->samples = n;
+    res->max = max;
+    res->mean = n ? sum / n : 0;
+    res->stddev = n > 1 ? sqrt((sum2 - sum * sum / n) / (n - 1)) : 0;
+    res->above150 = n ? 100.0 * above150 / n : 0;
+    res->above250 = n ? 100.0 * above250 / n : 0;
+    res->mae = nref ? err / nref : -1;
+    res->rmse = nref ? sqrt(err2 / nref) : -1;
+}
+
+/**
+ * @brief : thread : take the next item until all done
+ */
+static void worker() {
+    size_t item, total = sets.size() * recs.size();
+
+    while ((item = next_item.fetch_add(1)) < total) {
+        run_item(&sets[item / recs.size()], &recs[item % recs.size()], &results[item]);
+    }
+}
+
+static void print_line(const parset *ps, const char *name, const result *r) {
+
+    printf("%d,%d,%d,%d,", ps->offset, ps->learning, ps->gating, ps->std_initial);
+    if (name) printf("%s,", name);
+    printf("%u,%.2f,%.2f,%d,%.2f,%.2f,", r->samples, r->mean, r->stddev, r->max, r->above150, r->above250);
+
+    if (r->mae < 0) printf(",\n");
+    else printf("%.3f,%.3f\n", r->mae, r->rmse);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-o list] [-l list] [-g list] [-s list] [-j threads] [-v] recording ...\n", prog);
+    fprintf(stderr, "  list : comma separated values and/or ranges first:last:step\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<int16_t> offsets(1, 100), learnings(1, 12), gatings(1, 180), stds(1, 50);
+    std::vector<std::thread> threads;
+    unsigned nthreads = std::thread::hardware_concurrency();
+    bool verbose = false, ok = true;
+    int opt;
+    size_t s, r;
+
+    while ((opt = getopt(argc, argv, "o:l:g:s:j:v")) != -1) {
+        switch (opt) {
+            case 'o': ok = parse_list(optarg, &offsets); break;
+            case 'l': ok = parse_list(optarg, &learnings); break;
+            case 'g': ok = parse_list(optarg, &gatings); break;
+            case 's': ok = parse_list(optarg, &stds); break;
+            case 'j': nthreads = (unsigned) atoi(optarg); break;
+            case 'v': verbose = true; break;
+            default:  usage(argv[0]);
+        }
+
+        if (! ok) {
+            fprintf(stderr, "invalid list for -%c: %s\n", opt, optarg);
+            usage(argv[0]);
+        }
+    }
+
+    if (optind >= argc) usage(argv[0]);
+    if (nthreads == 0) nthreads = 1;
+
+    recs.resize(argc - optind);
+    for (r = 0; r < recs.size(); r++)
+        if (! read_recording(argv[optind + r], &recs[r])) return(EXIT_FAILURE);
+
+    for (int16_t o : offsets)
+        for (int16_t l : learnings)
+            for (int16_t g : gatings)
+                for (int16_t st : stds)
+                    sets.push_back({o, l, g, st});
+
+    results.resize(sets.size() * recs.size());
+
+    if (nthreads > results.size()) nthreads = results.size();
+    for (unsigned t = 0; t < nthreads; t++) threads.push_back(std::thread(worker));
+    for (std::thread &t : threads) t.join();
+
+    // per parameter set : average over recordings
+    printf("offset,learning,gating,std,%ssamples,mean,stddev,max,above150,above250,mae,rmse\n", verbose ? "recording," : "");
+
+    for (s = 0; s < sets.size(); s++) {
+        result avg;
+        uint32_t nref = 0;
+
+        memset(&avg, 0, sizeof(avg));
+
+        for (r = 0; r < recs.size(); r++) {
+            result *res = &results[s * recs.size() + r];
+
+            if (verbose) print_line(&sets[s], recs[r].name.c_str(), res);
+
+            avg.samples += res->samples;
+            avg.mean += res->mean;
+            avg.stddev += res->stddev;
+            if (res->max > avg.max) avg.max = res->max;
+            avg.above150 += res->above150;
+            avg.above250 += res->above250;
+
+            if (res->mae >= 0) {
+                avg.mae += res->mae;
+                avg.rmse += res->rmse;
+                nref++;
+            }
+        }
+
+        avg.mean /= recs.size();
+        avg.stddev /= recs.size();
+        avg.above150 /= recs.size();
+        avg.above250 /= recs.size();
+
+        if (nref) {
+            avg.mae /= nref;
+            avg.rmse /= nref;
+        }
+        else
+            avg.mae = avg.rmse = -1;
+
+        if (verbose) print_line(&sets[s], "all", &avg);
+        else print_line(&sets[s], NULL, &avg);
+    }
+
+    return(EXIT_SUCCESS);
+}
@@ -0,0 +1,174 @@
+/**
+ * SVM40 wait strategy benchmark
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Reads samples from the simulated sensor (extras/host/svm40_sim.h) with
+ * each wait strategy (SetWait()) and shows per sample :
+ *
+ *   wall   : mS the call took
+ *   cpu    : mS of CPU time used (what keeps an MCU awake)
+ *   waited : mS the driver spent in waits (GetStats())
+ *
+ * The strategies :
+ *
+ *   delay  : no wait routine, delay() (on the host this sleeps)
+ *   busy   : spin on millis() (as delay() on an AVR)
+ *   yield  : svm40_wait_yield(), spin and call yield()
+ *   sleep  : nanosleep() (as an RTOS task delay or MCU sleep)
+ *   poll   : poll() on a file descriptor with a timeout (as a host that
+ *            waits for input on the serial port)
+ *
+ * This runs in real time.
+ *
+ * Compile on Linux :
+ *   g++ -O2 -I../host -I../../src wait.cpp ../host/host.cpp ../host/svm40_sim.cpp \
+ *       ../../src/svm40.cpp ../../src/svm40_bus.cpp -o wait
+ *
+ * Usage :
+ *   wait [options]
+ *
+ *   -n num    samples per strategy (default 10)
+ *   -i        use I2C (default UART)
+ *********************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include "host.h"
+#include "svm40_sim.h"
+
+static void wait_busy(void *arg, uint32_t ms) {
+    uint32_t st = millis();
+    (void) arg;
+
+    while (millis() - st < ms) ;
+}
+
+static void wait_sleep(void *arg, uint32_t ms) {
+    struct timespec ts;
+    (void) arg;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+static void wait_poll(void *arg, uint32_t ms) {
+    struct pollfd p;
+
+    p.fd = *(int *) arg;
+    p.events = POLLIN;
+    poll(&p, 1, (int) ms);
+}
+
+static double cpu_ms() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return(ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0);
+}
+
+void usage(const char *name) {
+    fprintf(stderr, "usage : %s [-n num] [-i]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[]) {
+    int n = 10, opt, i, s, fd[2];
+    bool i2c = false;
+    struct svm40_values v;
+    struct svm40_stats st;
+    uint32_t wall, err;
+    double cpu;
+
+    struct {
+        const char    *name;
+        svm40_wait_cb cb;
+    } strategy[] = {
+        {"delay", NULL},
+        {"busy",  wait_busy},
+        {"yield", svm40_wait_yield},
+        {"sleep", wait_sleep},
+        {"poll",  wait_poll},
+    };
+
+    while ((opt = getopt(argc, argv, "n:i")) != -1) {
+        switch(opt) {
+            case 'n': n = atoi(optarg); break;
+            case 'i': i2c = true; break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if (n <= 0) usage(argv[0]);
+
+    // nothing is written, poll() only times out
+    if (pipe(fd) != 0) return(1);
+
+    host_realtime(true);
+
+    SVM40_Sim sim(i2c ? SVM40_SIM_I2C : SVM40_SIM_UART);
+    TwoWire wire;
+    SVM40 svm;
+
+    if (i2c) {
+        wire.attach(&sim);
+        svm.begin(&wire);
+    }
+    else
+        svm.begin(&sim);
+
+    svm.start();
+    svm.GetValues(&v);                  // wait for ready
+
+    printf("%s, %d samples per strategy\n\n", i2c ? "I2C" : "UART", n);
+    printf("strategy   wall mS    cpu mS  waited mS  errors\n");
+
+    for (s = 0; s < (int) (sizeof(strategy) / sizeof(strategy[0])); s++) {
+
+        svm.SetWait(strategy[s].cb, &fd[0]);
+        svm.ClearStats();
+
+        err = 0;
+        wall = millis();
+        cpu = cpu_ms();
+
+        for (i = 0; i < n; i++)
+            if (svm.GetValues(&v) != ERR_OK) err++;
+
+        cpu = cpu_ms() - cpu;
+        wall = millis() - wall;
+        svm.GetStats(&st);
+
+        printf("%-8s %9.1f %9.2f %10.1f  %6u\n", strategy[s].name, (double) wall / n,
+               cpu / n, st.wait_us / 1000.0 / n, err);
+    }
+
+    return(0);
+}
@@ -30,21 +30,18 @@
 #define _PRINTF_BUFFER_LENGTH_      64
 #define _Stream_Obj_                Serial
 
-#if 1
-static char _pf_buffer_[_PRINTF_BUFFER_LENGTH_];
-#else
-extern char _pf_buffer_[_PRINTF_BUFFER_LENGTH_];
-#endif
-
+// Version 1.3 : buffer on the stack, so printf can be used from several tasks
 
 #define printf(a,...)                                                       \
     do {                                                                    \
+    char _pf_buffer_[_PRINTF_BUFFER_LENGTH_];                               \
     snprintf(_pf_buffer_, sizeof(_pf_buffer_), a, ##__VA_ARGS__);           \
     _Stream_Obj_.print(_pf_buffer_);                                        \
     }while(0)
 
 #define printfn(a,...)                                                      \
     do{                                                                     \
+    char _pf_buffer_[_PRINTF_BUFFER_LENGTH_];                               \
     snprintf(_pf_buffer_, sizeof(_pf_buffer_), a"\r\n", ##__VA_ARGS__);     \
     _Stream_Obj_.print(_pf_buffer_);                                        \
     }while(0)
@@ -45,10 +45,38 @@
  *
  * Version 2.1 / October 2023 / paulvha
  *  - fixed setVocState in I2C mode
+ *
+ * Version 2.2 / October 2026 / paulvha
+ *  - split GetValues() in GetRawValues() and DecodeValues()
+ *  - temperature and humidity are now decoded as signed values
+ *  - added svm40_channel_value()
+ *  - added SetTrace()
+ *  - added GetStats()
+ *  - UART : discard bytes left from an earlier answer before sending a command
+ *  - hardened receive : buffer bound, frame length and stuffing checked, I2C
+ *    reads limited to request, device info limited to received bytes
+ *  - _started is now initialized in the constructor
+ *  - added SVM40_MINIMAL profile and SVM40_NO_DEBUG
+ *  - added SetLock(), DebugPrintf() buffer on the stack (thread safe)
+ *  - added begin(SVM40_Bus *) : hold a shared bus for write and read only
+ *  - I2C answers longer than the Wire buffer are read in parts
+ *  - added beginConfig() / Stage*() / commit() : one stop / start for all settings
+ *  - UART : SetVocTuningParameters() did not send the parameters, SetVocState()
+ *    sent the GET command
+ *  - added syncConfig() : write only what differs, StoreNvData() only if needed
+ *  - detect a reboot of the sensor, restore configuration / state and restart
+ *  - added discover() : version, serial, product name / type read once and cached
+ *  - start() / reset() do not wait, the next command waits what is left or
+ *    returns ERR_NOTREADY (SetReadyWait())
+ *  - added SetBudget() / Within() : time budget per call, ERR_DEADLINE
+ *  - added SetWait() : waits through a routine (yield, RTOS, sleep), wait time in
+ *    GetStats()
  *********************************************************************
  */
 
 #include "svm40.h"
+#include "svm40_bus.h"
+#include <stddef.h>               // offsetof
 
 #if !defined INCLUDE_I2C && !defined INCLUDE_UART
 #error you must enable either I2C or UART communication
@@ -62,22 +90,54 @@ SVM40::SVM40(void) {
   _Receive_BUF_Length = 0;
   _SVM40_Debug = false;
   _SelectTemp = true;          // default to celsius
+  _started = false;            // measurement not started
+  _Sensor_Comms = NONE;
   _FW_major = 0;               // Firmware level unknown
+  _info = NULL;                // no device information cached
+  _ready_pending = false;      // sensor ready
+  _ready_wait = true;          // wait for ready
+  _instr_err = ERR_OK;
+  _budget = _budget_once = 0;  // no time budget
+  _deadline_set = false;
+  _depth = 0;
+  _trace = NULL;
+  _lock = NULL;
+  _wait = NULL;                // wait with delay()
+  _cfg_staged = 0;             // no configuration staged
+  _recover = true;             // recover after a sensor reboot
+  _reboots = 0;
+  _reboot_cfg = NULL;
+  _reboot_cb = NULL;
+#if defined INCLUDE_I2C
+  _bus = NULL;
+#endif
+  ClearStats();
 }
 
+#if defined SVM40_MINIMAL
+uint8_t SVM40::_Receive_BUF[MAXRECVBUFLENGTH];
+uint8_t SVM40::_Send_BUF[MAXSENDBUFLENGTH];
+#endif
+
 /**
  * @brief Print debug message if enabled
  *
  */
+#if defined SVM40_NO_DEBUG
+
+// remove the messages, also from flash / RAM
+#define DebugPrintf(...) do {} while(0)
+
+#else
 
-static char prfbuf[256];
 void SVM40::DebugPrintf(const char *pcFmt, ...) {
     va_list pArgs;
+    char prfbuf[100];           // on the stack : thread safe
 
     if (_SVM40_Debug){
 
         va_start(pArgs, pcFmt);
-        vsprintf(prfbuf, pcFmt, pArgs);
+        vsnprintf(prfbuf, sizeof(prfbuf), pcFmt, pArgs);
         va_end(pArgs);
 
         if (_SVM40_Debug_Serial == STANDARD)
@@ -89,6 +149,7 @@ void SVM40::DebugPrintf(const char *pcFmt, ...) {
 #endif
     }
 }
+#endif // SVM40_NO_DEBUG
 
 /**
  * @brief Manual assigment of the serial communication port
@@ -103,6 +164,7 @@ bool SVM40::begin(Stream &serialPort) {
     _serial  = &serialPort; // Grab which port the user wants us to use
     return true;
 #else
+    (void) serialPort;
     DebugPrintf("UART communication not enabled\n");
     return(false);
 #endif // INCLUDE_UART
@@ -121,6 +183,7 @@ bool SVM40::begin(Stream *serialPort) {
     _serial  = serialPort; // Grab which port the user wants us to use
     return true;
 #else
+    (void) serialPort;
     DebugPrintf("UART communication not enabled\n");
     return(false);
 #endif // INCLUDE_UART
@@ -138,8 +201,28 @@ bool SVM40::begin(TwoWire *wirePort) {
     _Sensor_Comms = I2C_COMMS;
     _i2cPort = wirePort;            // Grab which port the user wants us to use
     _i2cPort->setClock(100000);     // Apollo3 is default 400K (although stated differently in 2.0.1)
+    _bus = NULL;
+    return true;
+#else
+    (void) wirePort;
+    DebugPrintf("I2C communication not enabled\n");
+    return(false);
+#endif // INCLUDE_I2C
+}
+
+/**
+ * @brief Assigment of a shared I2C bus
+ *
+ * @param bus : arbiter of the shared I2C communication channel
+ * The other devices on the bus must support 100 kHz
+ */
+bool SVM40::begin(SVM40_Bus *bus) {
+#if defined INCLUDE_I2C
+    if (! begin(bus->GetWire())) return(false);
+    _bus = bus;
     return true;
 #else
+    (void) bus;
     DebugPrintf("I2C communication not enabled\n");
     return(false);
 #endif // INCLUDE_I2C
@@ -155,7 +238,8 @@ bool SVM40::probe() {
 
     SVM40_version v;
 
-    if (GetVersion(&v) == ERR_OK) return(true);
+    // always ask the sensor, also after discover()
+    if (ReadVersion(&v) == ERR_OK) return(true);
 
     return(false);
 }
@@ -177,6 +261,110 @@ void SVM40::EnableDebugging(uint8_t act, debug_serial SelectDebugSerial) {
     _SVM40_Debug_Serial = SelectDebugSerial;
 }
 
+/**
+ * @brief : call a routine with every byte sent and received
+ * @param cb  : routine to call (NULL to stop)
+ * @param arg : passed to the routine
+ */
+void SVM40::SetTrace(svm40_trace_cb cb, void *arg) {
+    _trace = cb;
+    _trace_arg = arg;
+}
+
+/**
+ * @brief : set a routine to lock / unlock the instance
+ * @param cb  : routine to call (NULL = no locking)
+ * @param arg : passed to the routine
+ */
+void SVM40::SetLock(svm40_lock_cb cb, void *arg) {
+    _lock = cb;
+    _lock_arg = arg;
+}
+
+/**
+ * @brief : read the device identity and capabilities once
+ * @param d : structure to hold the information
+ *
+ * The SVM40 handles one command at a time on both transports, so the
+ * reads can not overlap. They are done once here and later calls are
+ * answered from d.
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::discover(struct svm40_device_info *d) {
+    Guard guard(this);                  // see SetLock()
+    uint8_t ret;
+
+    _info = NULL;                       // read from the sensor
+    memset(d, 0x0, sizeof(struct svm40_device_info));
+
+    ret = ReadVersion(&d->version);
+    if (ret != ERR_OK) return(ret);
+
+    ret = Get_Device_info(SVM40_SHDLC_DEVICE_SERIAL, d->serial, SVM40_INFO_LEN);
+    if (ret != ERR_OK) return(ret);
+
+    // on I2C these are not supported and cause no bus traffic
+    ret = Get_Device_info(SVM40_SHDLC_DEVICE_PRODUCT_NAME, d->product_name, SVM40_INFO_LEN);
+    if (ret != ERR_OK) return(ret);
+
+    ret = Get_Device_info(SVM40_SHDLC_DEVICE_PRODUCT_TYPE, d->product_type, SVM40_INFO_LEN);
+    if (ret != ERR_OK) return(ret);
+
+#if defined INCLUDE_UART
+    if (_Sensor_Comms != I2C_COMMS)
+        d->caps = SVM40_CAP_UPTIME | SVM40_CAP_PRODUCT_NAME | SVM40_CAP_PRODUCT_TYPE;
+#endif
+
+    if (d->version.major == 1) d->caps |= SVM40_CAP_OFFSET_FLOAT;
+
+    _info = d;
+    return(ERR_OK);
+}
+
+/**
+ * @brief : set how the driver waits
+ * @param cb  : routine to call (NULL = delay())
+ * @param arg : passed to the routine
+ */
+void SVM40::SetWait(svm40_wait_cb cb, void *arg) {
+    _wait = cb;
+    _wait_arg = arg;
+}
+
+/**
+ * @brief : wait for the sensor
+ * @param ms : mS to wait
+ *
+ * The wait routine may return earlier, so it is called until the time
+ * has passed. The time is added to the statistics.
+ */
+void SVM40::Wait(uint32_t ms) {
+    uint32_t st = micros();
+    uint32_t st_ms = millis();
+
+    if (_wait == NULL) delay(ms);
+    else {
+        while (millis() - st_ms < ms)
+            _wait(_wait_arg, ms - (millis() - st_ms));
+    }
+
+    _stats.wait_us += micros() - st;
+}
+
+/**
+ * @brief : wait routine that calls yield() until the time has passed
+ * @param arg : not used
+ * @param ms  : mS to wait
+ */
+void svm40_wait_yield(void *arg, uint32_t ms) {
+    uint32_t st = millis();
+    (void) arg;
+
+    while (millis() - st < ms) yield();
+}
+
 /**
  * @brief Read version info
  * @param : pointer to structure to store
@@ -185,6 +373,24 @@ void SVM40::EnableDebugging(uint8_t act, debug_serial SelectDebugSerial) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetVersion(SVM40_version *v) {
+
+    if (_info) {
+        *v = _info->version;
+        return(ERR_OK);
+    }
+
+    return(ReadVersion(v));
+}
+
+/**
+ * @brief Read version info from the sensor
+ * @param : pointer to structure to store
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::ReadVersion(SVM40_version *v) {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret, offset;
     memset(v, 0x0, sizeof(struct SVM40_version));
 
@@ -211,7 +417,9 @@ uint8_t SVM40::GetVersion(SVM40_version *v) {
         offset = 5;
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     v->major = _Receive_BUF[offset + 0];
@@ -242,7 +450,7 @@ uint8_t SVM40::GetVersion(SVM40_version *v) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetSystemUpTime(uint32_t *val) {
-    uint8_t ret;
+    Guard guard(this);                  // see SetLock()
     uint8_t offset;
 
 #if defined INCLUDE_I2C
@@ -266,7 +474,7 @@ uint8_t SVM40::GetSystemUpTime(uint32_t *val) {
         // fill buffer to send
         if (SHDLC_fill_buffer(SVM40_SHDLC_NO_BASE_VALUE, SVM40_SHDLC_SYSTEM_UPTIME) != true) return(ERR_PARAMETER);
 
-        ret = SHDLC_ReadFromSerial();
+        uint8_t ret = SHDLC_ReadFromSerial();
 
         if (ret != ERR_OK) return (ret);
 
@@ -280,7 +488,9 @@ uint8_t SVM40::GetSystemUpTime(uint32_t *val) {
     }
 
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     *val = (((uint32_t)_Receive_BUF[offset] << 24) | ((uint32_t)_Receive_BUF[offset+1] << 16) | \
@@ -305,6 +515,7 @@ uint8_t SVM40::GetSystemUpTime(uint32_t *val) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetVocState(uint8_t *p) {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret, offset, i;
 
 #if defined INCLUDE_I2C
@@ -338,7 +549,9 @@ uint8_t SVM40::GetVocState(uint8_t *p) {
         }
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     for(i = 0; i < 8; i++)  p[i] = _Receive_BUF[offset +i];
@@ -370,13 +583,26 @@ uint8_t SVM40::GetVocState(uint8_t *p) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetVocTuningParameters(struct svm_algopar *p) {
-    uint8_t ret, offset, i;
+    Guard guard(this);                  // see SetLock()
 
     // measurement started already?
     if ( !_started ) {
         if ( ! start() ) return(ERR_CMDSTATE);
     }
 
+    return(ReadVocTuning(p));
+}
+
+/**
+ * @brief : read the VOC tuning parameters (in any state)
+ * @param : pointer to store tuning parameters
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::ReadVocTuning(struct svm_algopar *p) {
+    uint8_t ret, offset;
+
 #if defined INCLUDE_I2C
     if (_Sensor_Comms == I2C_COMMS) {
 
@@ -409,7 +635,9 @@ uint8_t SVM40::GetVocTuningParameters(struct svm_algopar *p) {
         }
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     p->voc_index_offset = byte_to_uint16(offset);
@@ -428,15 +656,38 @@ uint8_t SVM40::GetVocTuningParameters(struct svm_algopar *p) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::SetVocTuningParameters(struct svm_algopar *p) {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret;
     bool restart = _started;
-    uint8_t data[8];
 
     // measurement started already?
     if ( _started ) {
-        if ( ! stop() ) return(ERR_CMDSTATE);
+        ret = StopIdle();
+        if (ret != ERR_OK) return(ret);
+    }
+
+    ret = WriteVocTuning(p);
+
+    // measurement restart ? (also past the time budget)
+    _deadline_set = false;
+    if ( restart ) {
+        if ( ! start() ) return(ERR_CMDSTATE);
     }
 
+    return(ret);
+}
+
+/**
+ * @brief : write the VOC tuning parameters (sensor must be idle)
+ * @param : pointer to the structure containing the values
+ *
+ * @return
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::WriteVocTuning(struct svm_algopar *p) {
+    uint8_t ret;
+    uint8_t data[8];
+
     data[0] = p->voc_index_offset >> 8;
     data[1] = p->voc_index_offset & 0xff;
     data[2] = p->learning_time_hours >> 8;
@@ -460,18 +711,13 @@ uint8_t SVM40::SetVocTuningParameters(struct svm_algopar *p) {
         // fill buffer to send
         if (SHDLC_fill_buffer(SVM40_SHDLC_BASELINE_ALG, SVM40_SHDLC_SET_VOC_TUNING, 8, data) != true) return(ERR_PARAMETER);
 
-        SHDLC_SendToSerial();
-
         ret = SHDLC_ReadFromSerial();
     }
 #else
-    {}
-#endif // INCLUDE_UART
-
-    // measurement restart ?
-    if ( restart ) {
-        if ( ! start() ) return(ERR_CMDSTATE);
+    {
+        return(ERR_PARAMETER);          // no begin()
     }
+#endif // INCLUDE_UART
 
     return(ret);
 }
@@ -490,10 +736,14 @@ uint8_t SVM40::SetVocTuningParameters(struct svm_algopar *p) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetTemperatureOffset(int16_t *val) {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret, offset,len;
 
+    // firmware level needed for the format
     if (_FW_major == 0) {
-        if (!probe()) return(ERR_PARAMETER);
+        SVM40_version ver;
+        ret = ReadVersion(&ver);
+        if (ret != ERR_OK) return(ret);
     }
 
     // Firmware level 1 is sending float (4 bytes)
@@ -508,6 +758,8 @@ uint8_t SVM40::GetTemperatureOffset(int16_t *val) {
 
         I2C_fill_buffer(SVM40_I2C_GET_TEMP_OFFSET);
         ret = I2C_RequestFromSVM(len);
+
+        if (ret != ERR_OK) return (ret);
     }
     else
 #endif // INCLUDE_I2C
@@ -527,17 +779,18 @@ uint8_t SVM40::GetTemperatureOffset(int16_t *val) {
         ///           0    1   2    3     4     5
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     // did we get a float (FW version 1.x)
     if (len == 4 ){
         float a = byte_to_float(offset);
-        Serial.println(a);
-        *val = (uint16_t) a;
+        *val = (int16_t) a;
     }
-    else {    //(FW version > 1.x)
-        *val = byte_to_uint16(offset) / 200;
+    else {    //(FW version > 1.x) signed, scaling 200
+        *val = (int16_t) byte_to_uint16(offset) / 200;
     }
 
     return(ERR_OK);
@@ -556,18 +809,44 @@ uint8_t SVM40::GetTemperatureOffset(int16_t *val) {
  *  else error
  */
 uint8_t SVM40::SetTemperatureOffset(int16_t val) {
-    uint8_t len, ret;
-    uint8_t data[4];
-    uint16_t v;
+    Guard guard(this);                  // see SetLock()
+    uint8_t ret;
     bool restart = _started;
 
     //  can only be done in idle mode
     if ( _started ) {
-        if ( ! stop() ) return(ERR_CMDSTATE);
+        ret = StopIdle();
+        if (ret != ERR_OK) return(ret);
+    }
+
+    ret = WriteTemperatureOffset(val);
+
+    // measurement restart ? (also past the time budget)
+    _deadline_set = false;
+    if ( restart ) {
+        if ( ! start() ) return(ERR_CMDSTATE);
     }
 
+    return(ret);
+}
+
+/**
+ * @brief : write the temperature offset (sensor must be idle)
+ * @param : temperature offset value in degrees celsius.
+ *
+ * @return
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::WriteTemperatureOffset(int16_t val) {
+    uint8_t len, ret;
+    uint8_t data[4];
+    uint16_t v;
+
+    // firmware level needed for the format
     if (_FW_major == 0) {
-        if (!probe()) return(ERR_PARAMETER);
+        SVM40_version ver;
+        ret = ReadVersion(&ver);
+        if (ret != ERR_OK) return(ret);
     }
 
     // Firmware level 1 is expecting float (4 bytes)
@@ -597,19 +876,14 @@ uint8_t SVM40::SetTemperatureOffset(int16_t val) {
         // fill buffer to send
         if (SHDLC_fill_buffer(SVM40_SHDLC_BASELINE_ALG, SVM40_SHDLC_SET_TEMP_OFFSET, len, data) != true) return(ERR_PARAMETER);
 
-        SHDLC_SendToSerial();
-
         // check response
         ret = SHDLC_ReadFromSerial();
     }
 #else
-    {}
-#endif // INCLUDE_UART
-
-    // measurement restart ?
-    if ( restart ) {
-        if ( ! start() ) return(ERR_CMDSTATE);
+    {
+        return(ERR_PARAMETER);          // no begin()
     }
+#endif // INCLUDE_UART
 
     return(ret);
 }
@@ -629,36 +903,279 @@ uint8_t SVM40::SetTemperatureOffset(int16_t val) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::SetVocState(uint8_t *p) {
+    Guard guard(this);                  // see SetLock()
+    uint8_t ret;
+    bool restart = _started;
+
+    //  can only be done in idle mode
+    if ( _started ) {
+        ret = StopIdle();
+        if (ret != ERR_OK) return(ret);
+    }
+
+    ret = WriteVocState(p);
+
+    // measurement restart ? (also past the time budget)
+    _deadline_set = false;
+    if ( restart ) {
+        if ( ! start() ) return(ERR_CMDSTATE);
+    }
+
+    return(ret);
+}
+
+/**
+ * @brief : write VOC algorithm state (sensor must be idle)
+ * @param : pointer to array with data to restore
+ *
+ * @return
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::WriteVocState(uint8_t *p) {
     uint8_t ret;
+
+#if defined INCLUDE_I2C
+    if (_Sensor_Comms == I2C_COMMS) {
+
+        I2C_fill_buffer(SVM40_I2C_SET_VOC_STATE, 8, p); // modified V2.1
+        ret = I2C_SendToSVM();
+    }
+    else
+#endif // INCLUDE_I2C
+
+#if defined INCLUDE_UART
+    {
+        // fill buffer to send (was the GET command without reading the answer)
+        if (SHDLC_fill_buffer(SVM40_SHDLC_BASELINE_STATE, SVM40_SHDLC_SET_VOC_STATE, 8, p) != true) return(ERR_PARAMETER);
+
+        ret = SHDLC_ReadFromSerial();
+    }
+#else
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
+#endif // INCLUDE_UART
+
+    return(ret);
+}
+
+/**
+ * @brief : start a configuration transaction
+ *
+ * Any settings staged before, but not committed, are discarded.
+ */
+void SVM40::beginConfig() {
+    _cfg_staged = 0;
+}
+
+/**
+ * @brief : stage a setting for commit()
+ * @param : as with the Set* calls
+ */
+void SVM40::StageVocTuningParameters(struct svm_algopar *p) {
+    _cfg_tuning = *p;
+    _cfg_staged |= SVM40_CFG_TUNING;
+}
+
+void SVM40::StageTemperatureOffset(int16_t val) {
+    _cfg_offset = val;
+    _cfg_staged |= SVM40_CFG_OFFSET;
+}
+
+void SVM40::StageVocState(uint8_t *p) {
+    memcpy(_cfg_state, p, sizeof(_cfg_state));
+    _cfg_staged |= SVM40_CFG_STATE;
+}
+
+/**
+ * @brief : write all staged settings with one stop / start of the measurement
+ * @param store : true = store in non-volatile memory (StoreNvData())
+ *
+ * The settings that are changed are read first. If a write fails, the
+ * settings written before are restored. The VOC state can only be read
+ * during measurement, so it is only restored if the measurement was
+ * started. The measurement is restarted if it was started.
+ *
+ * @return :
+ *  ERR_OK = ok else error of the first write that failed
+ */
+uint8_t SVM40::commit(bool store) {
+    Guard guard(this);                  // see SetLock()
+    struct svm_algopar old_tuning;
+    int16_t old_offset;
+    uint8_t old_state[8];
+    uint8_t ret = ERR_OK, saved = 0, done = 0;
     bool restart = _started;
 
-    //  can only be done in idle mode
-    if ( _started ) {
-        if ( ! stop() ) return(ERR_CMDSTATE);
+    // keep the current settings for a rollback
+    if (_cfg_staged & SVM40_CFG_TUNING) {
+        if (ReadVocTuning(&old_tuning) == ERR_OK) saved |= SVM40_CFG_TUNING;
+    }
+
+    if (_cfg_staged & SVM40_CFG_OFFSET) {
+        if (GetTemperatureOffset(&old_offset) == ERR_OK) saved |= SVM40_CFG_OFFSET;
+    }
+
+    // a new tuning resets the VOC state as well
+    if (_started && (_cfg_staged & (SVM40_CFG_STATE | SVM40_CFG_TUNING))) {
+        if (GetVocState(old_state) == ERR_OK) saved |= SVM40_CFG_STATE;
+    }
+
+    //  can only be done in idle mode
+    if ( _started ) {
+        ret = StopIdle();
+        if (ret != ERR_OK) {
+            _cfg_staged = 0;
+            return(ret);
+        }
+    }
+
+    if (_cfg_staged & SVM40_CFG_OFFSET) {
+        ret = WriteTemperatureOffset(_cfg_offset);
+        if (ret == ERR_OK) done |= SVM40_CFG_OFFSET;
+    }
+
+    if (ret == ERR_OK && (_cfg_staged & SVM40_CFG_TUNING)) {
+        ret = WriteVocTuning(&_cfg_tuning);
+        if (ret == ERR_OK) done |= SVM40_CFG_TUNING | SVM40_CFG_STATE;
+    }
+
+    // after the tuning, as that resets the VOC state
+    if (ret == ERR_OK && (_cfg_staged & SVM40_CFG_STATE)) {
+        ret = WriteVocState(_cfg_state);
+        if (ret == ERR_OK) done |= SVM40_CFG_STATE;
+    }
+
+    if (ret == ERR_OK && store) ret = StoreNvData();
+
+    // rollback and restart, also past the time budget
+    _deadline_set = false;
+
+    // rollback
+    if (ret != ERR_OK) {
+        DebugPrintf("commit failed 0x%02X, restore 0x%02X\n", ret, done & saved);
+        done &= saved;
+        if (done & SVM40_CFG_OFFSET) WriteTemperatureOffset(old_offset);
+        if (done & SVM40_CFG_TUNING) WriteVocTuning(&old_tuning);
+        if (done & SVM40_CFG_STATE)  WriteVocState(old_state);
+    }
+
+    _cfg_staged = 0;
+
+    // measurement restart ?
+    if ( restart ) {
+        if ( ! start() && ret == ERR_OK) return(ERR_CMDSTATE);
+    }
+
+    return(ret);
+}
+
+/**
+ * @brief : CRC-8 (as used on I2C) over a configuration, except the crc
+ */
+uint8_t SVM40::ConfigCRC(struct svm40_config *c) {
+    uint8_t *p = (uint8_t *) c;
+    uint8_t crc = 0xFF;
+
+    for (uint8_t i = 0; i < offsetof(struct svm40_config, crc); i++) {
+        crc ^= p[i];
+        for (uint8_t bit = 8; bit > 0; --bit) {
+            if (crc & 0x80) crc = (crc << 1) ^ 0x31u;
+            else crc = (crc << 1);
+        }
+    }
+
+    return(crc);
+}
+
+/**
+ * @brief : set version and crc of a configuration
+ */
+void SVM40::SealConfig(struct svm40_config *c) {
+    c->version = SVM40_CONFIG_VERSION;
+    c->crc = ConfigCRC(c);
+}
+
+/**
+ * @brief : check version and crc of a configuration
+ */
+bool SVM40::CheckConfig(struct svm40_config *c) {
+    return(c->version == SVM40_CONFIG_VERSION && c->crc == ConfigCRC(c));
+}
+
+/**
+ * @brief : bring the sensor in line with a configuration
+ * @param c      : configuration
+ * @param report : if not NULL, set to what was done
+ * @param store  : store changed offset / tuning in non-volatile memory
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::syncConfig(struct svm40_config *c, uint8_t *report, bool store) {
+    Guard guard(this);                  // see SetLock()
+    SVM40_version v;
+    struct svm_algopar tuning;
+    uint8_t ret, done = 0;
+    int16_t offset;
+
+    if (report) *report = 0;
+
+    if (! CheckConfig(c)) {
+        DebugPrintf("configuration version or crc wrong\n");
+        return(ERR_PARAMETER);
+    }
+
+    if (c->fw_major != 0) {
+
+        ret = GetVersion(&v);
+        if (ret != ERR_OK) return(ret);
+
+        if (v.major != c->fw_major || v.minor != c->fw_minor) {
+            DebugPrintf("firmware %d.%d, expected %d.%d\n", v.major, v.minor, c->fw_major, c->fw_minor);
+            if (report) *report = SVM40_SYNC_FW;
+            return(ERR_FIRMWARE);
+        }
+    }
+
+    beginConfig();
+
+    if (c->flags & SVM40_CFG_OFFSET) {
+
+        ret = GetTemperatureOffset(&offset);
+        if (ret != ERR_OK) return(ret);
+
+        if (offset != c->temp_offset) {
+            StageTemperatureOffset(c->temp_offset);
+            done |= SVM40_CFG_OFFSET;
+        }
     }
 
-#if defined INCLUDE_I2C
-    if (_Sensor_Comms == I2C_COMMS) {
+    if (c->flags & SVM40_CFG_TUNING) {
 
-        I2C_fill_buffer(SVM40_I2C_SET_VOC_STATE, 8, p); // modified V2.1
-        ret = I2C_SendToSVM();
+        ret = ReadVocTuning(&tuning);
+        if (ret != ERR_OK) return(ret);
+
+        if (memcmp(&tuning, &c->tuning, sizeof(tuning)) != 0) {
+            StageVocTuningParameters(&c->tuning);
+            done |= SVM40_CFG_TUNING;
+        }
     }
-    else
-#endif // INCLUDE_I2C
 
-#if defined INCLUDE_UART
-    {
-        // fill buffer to send
-        if (SHDLC_fill_buffer(SVM40_SHDLC_BASELINE_STATE, SVM40_SHDLC_GET_VOC_STATE, 8, p) != true) return(ERR_PARAMETER);
-        ret = SHDLC_SendToSerial();
+    // the VOC state is not part of the configuration : it changes every
+    // second during measurement and a stored copy is only valid for 10
+    // minutes (see svm40_checkpoint.h or SetVocState())
+
+    if (done == 0) {
+        DebugPrintf("configuration is in sync\n");
+        return(ERR_OK);
     }
-#else
-    {}
-#endif // INCLUDE_UART
 
-    // measurement restart ?
-    if ( restart ) {
-        if ( ! start() ) return(ERR_CMDSTATE);
+    ret = commit(store);
+
+    if (ret == ERR_OK && report) {
+        *report = done;
+        if (store) *report |= SVM40_SYNC_STORED;
     }
 
     return(ret);
@@ -674,14 +1191,55 @@ uint8_t SVM40::SetVocState(uint8_t *p) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::GetValues(struct svm40_values *v) {
+    Guard guard(this);                  // see SetLock()
+    uint8_t ret;
+    struct svm40_raw r;
+
+    ret = GetRawValues(&r);
+    if (ret != ERR_OK) return(ret);
+
+    DecodeValues(&r, v);
+
+    return(ERR_OK);
+}
+
+/**
+ * @brief : read all values from the sensor as received (no conversion)
+ * @param : pointer to structure to store
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::GetRawValues(struct svm40_raw *r) {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret;
-    uint8_t offset;
 
     // measurement started already?
     if ( !_started ) {
         if ( ! start() ) return(ERR_CMDSTATE);
     }
 
+    ret = ReadRaw(r);
+
+    // sensor rebooted (or stopped) : restart and try again
+    if (ret != ERR_OK && ret != ERR_NOTREADY && ret != ERR_DEADLINE && _recover && CheckReboot(ret)) {
+        if (Recover()) ret = ReadRaw(r);
+    }
+
+    return(ret);
+}
+
+/**
+ * @brief : read all values from the sensor as received
+ * @param : pointer to structure to store
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40::ReadRaw(struct svm40_raw *r) {
+    uint8_t ret;
+    uint8_t offset;
+
 #if defined INCLUDE_I2C
     if (_Sensor_Comms == I2C_COMMS) {
 
@@ -712,19 +1270,130 @@ uint8_t SVM40::GetValues(struct svm40_values *v) {
             return(ERR_DATALENGTH);
         }
     }
+#else
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
+#endif // INCLUDE_UART
+
+    if (ret != ERR_OK) return(ret);
+
+    // get data
+    r->VOC_index = byte_to_uint16(offset);
+    r->humidity = (int16_t) byte_to_uint16(offset+2);
+    r->temperature = (int16_t) byte_to_uint16(offset+4);
+    r->raw_voc_ticks = byte_to_uint16(offset+6);
+    r->raw_humidity = (int16_t) byte_to_uint16(offset+8);
+    r->raw_temperature = (int16_t) byte_to_uint16(offset+10);
+
+    return(ERR_OK);
+}
+
+/**
+ * @brief : recover after a reboot of the sensor
+ * @param act : true = enable (default), false = disable
+ * @param c   : configuration to restore (NULL = none)
+ */
+void SVM40::SetRebootRecovery(bool act, struct svm40_config *c) {
+    _recover = act;
+    _reboot_cfg = c;
+}
+
+/**
+ * @brief : set routine to call after a reboot was detected
+ */
+void SVM40::SetRebootHandler(svm40_reboot_cb cb, void *arg) {
+    _reboot_cb = cb;
+    _reboot_arg = arg;
+}
+
+/**
+ * @brief : check whether the sensor is idle, after a read failed
+ * @param ret : error of the read
+ *
+ * I2C : the sensor does not answer a read in idle, but does answer
+ *       GetVersion(). GetVocState() is only answered during measurement,
+ *       so a bus error is not taken for a reboot
+ * UART: the sensor returns a state error. If the uptime is more than
+ *       SVM40_REBOOT_MARGIN seconds less than the time since start() it
+ *       rebooted, else the measurement was stopped (e.g. by an other
+ *       program)
+ *
+ * @return :
+ *  true if the sensor is idle
+ */
+bool SVM40::CheckReboot(uint8_t ret) {
+    SVM40_version v;
+
+#if defined INCLUDE_I2C
+    if (_Sensor_Comms == I2C_COMMS) {
+        uint8_t state[8];
+
+        if (ret != ERR_PROTOCOL && ret != ERR_DATALENGTH) return(false);
+        if (ReadVersion(&v) != ERR_OK) return(false);
+        if (GetVocState(state) == ERR_OK) return(false);
+
+        _reboots++;
+        return(true);
+    }
+    else
+#endif // INCLUDE_I2C
+#if defined INCLUDE_UART
+    {
+        uint32_t up;
+        (void) v;
+
+        if ((ret & 0x7f) != SVM40_ERR_STAT) return(false);
+
+        // uptime clearly less than the time since start() : rebooted.
+        // Both are truncated to seconds and the clocks differ a little
+        if (GetSystemUpTime(&up) == ERR_OK && up + SVM40_REBOOT_MARGIN < (millis() - _start_ms) / 1000) _reboots++;
+        else DebugPrintf("measurement was stopped\n");
+
+        return(true);
+    }
 #else
     {}
+    return(false);
 #endif // INCLUDE_UART
+}
+
+/**
+ * @brief : restore configuration and state and restart the measurement
+ *
+ * @return :
+ *   true on success else false
+ */
+bool SVM40::Recover() {
+
+    DebugPrintf("sensor idle, recover (reboots %d)\n", _reboots);
+
+    _started = false;
+
+    // syncConfig() leaves the VOC state alone. The handler restores a
+    // recent state (after the tuning, that resets the state)
+    if (_reboot_cfg) syncConfig(_reboot_cfg, NULL, false);
+
+    if (_reboot_cb) _reboot_cb(_reboot_arg);
+
+    return(start());
+}
+
+/**
+ * @brief : translate raw values to measurement values
+ * @param r : pointer to raw values (as from GetRawValues())
+ * @param v : pointer to structure to store
+ */
+void SVM40::DecodeValues(struct svm40_raw *r, struct svm40_values *v) {
 
     memset(v,0x0,sizeof(struct svm40_values));
 
-    // get data
-    v->VOC_index = byte_to_uint16(offset) / 10;
-    v->humidity = ((float) byte_to_uint16(offset+2)) / 100;
-    v->temperature = ((float) byte_to_uint16(offset+4)) / 200;
-    v->raw_voc_ticks = byte_to_uint16(offset+6);
-    v->raw_humidity = ((float) byte_to_uint16(offset+8)) / 100;
-    v->raw_temperature = ((float) byte_to_uint16(offset+10)) / 200;
+    v->VOC_index = r->VOC_index / 10;
+    v->humidity = ((float) r->humidity) / 100;
+    v->temperature = ((float) r->temperature) / 200;
+    v->raw_voc_ticks = r->raw_voc_ticks;
+    v->raw_humidity = ((float) r->raw_humidity) / 100;
+    v->raw_temperature = ((float) r->raw_temperature) / 200;
     v->Celsius = _SelectTemp;
 
     // perform some calculations
@@ -739,8 +1408,6 @@ uint8_t SVM40::GetValues(struct svm40_values *v) {
         v->heat_index = (v->heat_index * 1.8) + 32;
         v->dew_point =(v->dew_point * 1.8) + 32;
     }
-
-    return(ERR_OK);
 }
 
 /**
@@ -759,6 +1426,7 @@ void SVM40::SetTempCelsius(bool act) {
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::StoreNvData() {
+    Guard guard(this);                  // see SetLock()
     uint8_t ret;
 
 #if defined INCLUDE_I2C
@@ -775,17 +1443,106 @@ uint8_t SVM40::StoreNvData() {
         // fill buffer to send
         if (SHDLC_fill_buffer(SVM40_SHDLC_BASELINE_ALG, SVM40_SHDLC_STORE_NVRAM) != true) return(ERR_PARAMETER);
 
-        SHDLC_SendToSerial();
-
         ret = SHDLC_ReadFromSerial();
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     return(ret);
 }
 
+/**
+ * @brief : set the time the sensor is ready
+ * @param ms : mS from now
+ */
+void SVM40::SetReadyAt(uint32_t ms) {
+    _ready_at = millis() + ms;
+    _ready_pending = true;
+}
+
+/**
+ * @brief : mS left before the sensor is ready after start() / reset()
+ *
+ * @return :
+ *  mS left, 0 = ready
+ */
+uint32_t SVM40::GetReadyIn() {
+    int32_t left;
+
+    if (! _ready_pending) return(0);
+
+    // works across the wrap of millis()
+    left = (int32_t) (_ready_at - millis());
+
+    if (left <= 0) {
+        _ready_pending = false;
+        return(0);
+    }
+
+    return((uint32_t) left);
+}
+
+/**
+ * @brief : start the time budget of a call (see SetBudget())
+ */
+void SVM40::StartBudget() {
+    uint32_t ms = _budget_once ? _budget_once : _budget;
+
+    _budget_once = 0;
+    _deadline_set = ms != 0;
+    _deadline = millis() + ms;
+}
+
+/**
+ * @brief : mS left of the time budget of the current call
+ *
+ * @return :
+ *  mS left (0 = passed) or SVM40_NO_DEADLINE
+ */
+uint32_t SVM40::TimeLeft() {
+    int32_t left;
+
+    if (! _deadline_set) return(SVM40_NO_DEADLINE);
+
+    left = (int32_t) (_deadline - millis());
+    return(left > 0 ? (uint32_t) left : 0);
+}
+
+/**
+ * @brief : called before a command is sent to the sensor
+ *
+ * Waits until the sensor is ready and checks that the answer can be there
+ * within the time budget.
+ *
+ * @return :
+ *  ERR_OK        : ready (after waiting the time left)
+ *  ERR_NOTREADY  : not ready and SetReadyWait(false)
+ *  ERR_DEADLINE  : the answer can not be there in time
+ */
+uint8_t SVM40::WaitReady() {
+    uint32_t left = GetReadyIn();
+
+    if (left > 0 && ! _ready_wait) {
+        DebugPrintf("sensor ready in %lu mS\n", (unsigned long) left);
+        return(ERR_NOTREADY);
+    }
+
+    if (left + _RespDelay > TimeLeft()) {
+        DebugPrintf("no time left for command\n");
+        return(ERR_DEADLINE);
+    }
+
+    if (left == 0) return(ERR_OK);
+
+    Wait(left);
+    _ready_pending = false;
+
+    return(ERR_OK);
+}
+
 /**
  * @brief : Instruct SVM40
  * @param type : type of instruction
@@ -794,6 +1551,7 @@ uint8_t SVM40::StoreNvData() {
  *   true on success else false
  */
 bool SVM40::Instruct(uint8_t type){
+    Guard guard(this);                  // see SetLock()
 
     uint8_t ret;
 
@@ -828,14 +1586,18 @@ bool SVM40::Instruct(uint8_t type){
         ret = SHDLC_ReadFromSerial();
     }
 #else
-    {}
+    {
+        _instr_err = ERR_PARAMETER;     // no begin()
+        return(false);
+    }
 #endif // INCLUDE_UART
 
     if (ret == ERR_OK){
 
         if (type == SVM40_SHDLC_START_MEASURE) {
             _started = true;
-            delay(1000);
+            _start_ms = millis();
+            SetReadyAt(START_DELAY_MS);
         }
         else if (type == SVM40_SHDLC_STOP_MEASURE)
             _started = false;
@@ -845,19 +1607,37 @@ bool SVM40::Instruct(uint8_t type){
 
 #if defined INCLUDE_I2C
             if (_Sensor_Comms == I2C_COMMS) {
+                if (_bus) _bus->Acquire();
                 _i2cPort->begin();       // some I2C channels need a reset
+                if (_bus) _bus->Release();
             }
 #endif
-            delay(2000);
+            SetReadyAt(RESET_DELAY_MS);
         }
 
         return(true);
     }
 
+    _instr_err = ret;
     DebugPrintf("instruction failed\n");
     return(false);
 }
 
+/**
+ * @brief : stop the measurement to change a setting
+ *
+ * @return :
+ *  ERR_OK, ERR_NOTREADY / ERR_DEADLINE (nothing sent) else ERR_CMDSTATE
+ */
+uint8_t SVM40::StopIdle() {
+
+    if (stop()) return(ERR_OK);
+
+    if (_instr_err == ERR_NOTREADY || _instr_err == ERR_DEADLINE) return(_instr_err);
+
+    return(ERR_CMDSTATE);
+}
+
 /**
  * @brief General Read device info
  *
@@ -873,7 +1653,23 @@ bool SVM40::Instruct(uint8_t type){
  *  ERR_OK = ok else error
  */
 uint8_t SVM40::Get_Device_info(uint8_t type, char *ser, uint8_t len) {
-    uint8_t ret,i, offset;
+    Guard guard(this);                  // see SetLock()
+    uint8_t ret,i, offset, rcv;
+    const char *c;
+
+    if (len == 0) return(ERR_PARAMETER);
+
+    // read before by discover()
+    if (_info) {
+        if (type == SVM40_SHDLC_DEVICE_SERIAL) c = _info->serial;
+        else if (type == SVM40_SHDLC_DEVICE_PRODUCT_NAME) c = _info->product_name;
+        else if (type == SVM40_SHDLC_DEVICE_PRODUCT_TYPE) c = _info->product_type;
+        else return(ERR_PARAMETER);
+
+        strncpy(ser, c, len - 1);
+        ser[len - 1] = 0x0;
+        return(ERR_OK);
+    }
 
 #if defined INCLUDE_I2C
 
@@ -888,11 +1684,13 @@ uint8_t SVM40::Get_Device_info(uint8_t type, char *ser, uint8_t len) {
         }
 
         else {
-            sprintf(ser,"Not Supported");
+            strncpy(ser, "Not Supported", len - 1);
+            ser[len - 1] = 0x0;
             return(ERR_OK);
         }
 
         offset = 0;
+        rcv = _Receive_BUF_Length;
     }
     else
 #endif // INCLUDE_I2C
@@ -905,25 +1703,52 @@ uint8_t SVM40::Get_Device_info(uint8_t type, char *ser, uint8_t len) {
         ret = SHDLC_ReadFromSerial();
 
         offset = 5;
+        rcv = _Receive_BUF[4];
     }
 #else
-    {}
+    {
+        return(ERR_PARAMETER);          // no begin()
+    }
 #endif // INCLUDE_UART
 
     if (ret != ERR_OK) return(ret);
 
-    // get data
-    for (i = 0; i < len ; i++) {
+    // get data (not more than received, always terminated)
+    if (rcv > len - 1) rcv = len - 1;
+
+    for (i = 0; i < rcv ; i++) {
         ser[i] = _Receive_BUF[i+offset];
         if (ser[i] == 0x0) break;
     }
 
+    ser[i] = 0x0;
+
     return(ret);
 }
 
 ////////////////////////////////////////////////////////////////
 // CALCULATIONS FOR SVM40                                     //
 ////////////////////////////////////////////////////////////////
+/**
+ * @brief : get the value of a channel
+ * @param v  : pointer to measurement values
+ * @param ch : channel to obtain
+ */
+float svm40_channel_value(struct svm40_values *v, svm40_channel ch) {
+
+    switch(ch) {
+        case SVM40_CH_TEMPERATURE:  return(v->temperature);
+        case SVM40_CH_HUMIDITY:     return(v->humidity);
+        case SVM40_CH_VOC_INDEX:    return((float) v->VOC_index);
+        case SVM40_CH_RAW_VOC:      return((float) v->raw_voc_ticks);
+        case SVM40_CH_HEAT_INDEX:   return(v->heat_index);
+        case SVM40_CH_DEW_POINT:    return(v->dew_point);
+        case SVM40_CH_DEW_SPREAD:   return(v->temperature - v->dew_point);
+        case SVM40_CH_ABS_HUMIDITY: return(v->absolute_hum);
+        default:                    return(0);
+    }
+}
+
 /**
  * @brief : calculate the absolute humidity from relative humidity [%RH *1000]
  * and temperature [mC]
@@ -1153,43 +1978,45 @@ uint8_t SVM40::SHDLC_ByteUnStuff(uint8_t b) {
  *  false ERROR
  */
 bool SVM40::SHDLC_fill_buffer(uint8_t lead, uint8_t command, uint8_t len, uint8_t *par) {
+    uint8_t frame[SHDLC_MAX_DATA + 5];  // address, command, length, data, CRC
+    int i = 0, j;
+    uint8_t tmp;
+
     memset(_Send_BUF,0x0,sizeof(_Send_BUF));
     _Send_BUF_Length = 0;
 
-    int i = 0;
-    uint8_t tmp;
+    if (len > SHDLC_MAX_DATA) return(false);
 
-    _Send_BUF[i++] = SHDLC_IND;
-    _Send_BUF[i++] = 0x0;               // SHDLC address SVM40 is zero
+    frame[i++] = 0x0;                   // SHDLC address SVM40 is zero
 
     if(lead != SVM40_SHDLC_NO_BASE_VALUE){
 
-        _Send_BUF[i++] = lead;
-        _Send_BUF[i++] = 1;     // length
-        _Send_BUF[i++] = command & 0xff;
+        frame[i++] = lead;
+        frame[i++] = 1;         // length
+        frame[i++] = command & 0xff;
 
         // check for additional data to be added
-        if (lead == SVM40_SHDLC_BASELINE_STATE && command == SVM40_SHDLC_SET_VOC_STATE){
-            for(tmp=0; tmp < len ; tmp++) _Send_BUF[i++] = par[tmp];
-            _Send_BUF[3] = len + 1;
-        }
-
-        else if (lead == SVM40_SHDLC_BASELINE_ALG && command == SVM40_SHDLC_SET_TEMP_OFFSET) {
-            for(tmp=0; tmp < len ; tmp++) _Send_BUF[i++] = par[tmp];
-            _Send_BUF[3] = len + 1;
+        if ((lead == SVM40_SHDLC_BASELINE_STATE && command == SVM40_SHDLC_SET_VOC_STATE) ||
+            (lead == SVM40_SHDLC_BASELINE_ALG && (command == SVM40_SHDLC_SET_TEMP_OFFSET || command == SVM40_SHDLC_SET_VOC_TUNING))) {
+            for(tmp=0; tmp < len ; tmp++) frame[i++] = par[tmp];
+            frame[2] = len + 1;
         }
     }
     else {
-        _Send_BUF[i++] = command;
-        _Send_BUF[i++] = 0;     // length
+        frame[i++] = command;
+        frame[i++] = 0;         // length
     }
 
-    // add CRC and check for byte stuffing
-    tmp = SHDLC_calc_CRC(_Send_BUF, 1, i);
-    i = SHDLC_ByteStuff(tmp, i);
+    // add CRC (of the bytes before stuffing)
+    frame[i] = SHDLC_calc_CRC(frame, 0, i - 1);
+    i++;
 
-    _Send_BUF[i] = SHDLC_IND;
-    _Send_BUF_Length = ++i;
+    // all between the start and stop byte is stuffed (e.g. a VOC state)
+    _Send_BUF[0] = SHDLC_IND;
+    for (j = 0, tmp = 1; j < i; j++) tmp = SHDLC_ByteStuff(frame[j], tmp);
+
+    _Send_BUF[tmp] = SHDLC_IND;
+    _Send_BUF_Length = ++tmp;
 
     // set for delay  (add V2)
     // time is set wider than datasheet to be sure
@@ -1242,13 +2069,25 @@ uint8_t SVM40::SHDLC_SendToSerial() {
         DebugPrintf("\n");
     }
 
+    // remove what is left from an earlier (broken) answer, else the
+    // answer to this command is read behind it and all frames that
+    // follow are out of sync
+    while (_serial->available()) {
+        i = _serial->read();
+        if (_trace) _trace(_trace_arg, SVM40_TRACE_RX, &i, 1);
+        _stats.bytes_rx++;
+    }
+
     for (i = 0 ; i <_Send_BUF_Length; i++)
         _serial->write(_Send_BUF[i]);
 
+    if (_trace) _trace(_trace_arg, SVM40_TRACE_TX, _Send_BUF, _Send_BUF_Length);
+    _stats.bytes_tx += _Send_BUF_Length;
+
     // indicate that command has been sent
     _Send_BUF_Length = 0;
     // wait
-    delay(_RespDelay);
+    Wait(_RespDelay);
 
     return(ERR_OK);
 }
@@ -1261,6 +2100,11 @@ uint8_t SVM40::SHDLC_SendToSerial() {
  */
 uint8_t SVM40::SHDLC_ReadFromSerial() {
     uint8_t ret;
+
+    // sensor busy with start / reset, time budget
+    ret = WaitReady();
+    if (ret != ERR_OK) return(ret);
+
     _serial->flush();
 
     // write to serial
@@ -1270,7 +2114,11 @@ uint8_t SVM40::SHDLC_ReadFromSerial() {
 
     // read serial
     ret = SHDLC_SerialToBuffer();
-    if (ret != ERR_OK) return(ret);
+    if (ret != ERR_OK) {
+        if (ret == ERR_TIMEOUT) _stats.timeouts++;
+        else if (ret != ERR_DEADLINE) _stats.protocol_errors++;
+        return(ret);
+    }
 
     /**
      * check CRC.
@@ -1284,9 +2132,12 @@ uint8_t SVM40::SHDLC_ReadFromSerial() {
     if (_Receive_BUF[_Receive_BUF_Length-1] != ret)
     {
         DebugPrintf("CRC error. expected 0x%02X, got 0x%02X\n",_Receive_BUF[_Receive_BUF_Length-1], ret);
+        _stats.crc_errors++;
         return(ERR_PROTOCOL);
     }
 
+    _stats.frames_ok++;
+
     // check status
     SHDLC_State(_Receive_BUF[3]);
 
@@ -1338,19 +2189,27 @@ void SVM40::SHDLC_State(uint8_t state)
  *   Err_OK is OK  else error
  */
 uint8_t SVM40::SHDLC_SerialToBuffer() {
-    uint32_t startTime;
+    uint32_t startTime, timeout;
     bool  byte_stuff = false;
-    uint8_t i;
+    uint8_t i, c;
 
     startTime = millis();
     i = 0;
 
+    // do not wait past the time budget (SetBudget())
+    timeout = TimeLeft();
+    if (timeout > TIME_OUT) timeout = TIME_OUT;
+
     // read until last 0x7E
     while (true)
     {
         while (_serial->available())
         {
-            _Receive_BUF[i] = _serial->read();
+            c = _serial->read();
+            if (_trace) _trace(_trace_arg, SVM40_TRACE_RX, &c, 1);
+            _stats.bytes_rx++;
+
+            _Receive_BUF[i] = c;
             // check for good header
             if (i == 0) {
 
@@ -1371,6 +2230,7 @@ uint8_t SVM40::SHDLC_SerialToBuffer() {
                 // handle byte stuffing
                 else if (byte_stuff) {
                     _Receive_BUF[i] = SHDLC_ByteUnStuff(_Receive_BUF[i]);
+                    if (_Receive_BUF[i] == 0) return(ERR_PROTOCOL);
                     byte_stuff = false;
                 }
 
@@ -1388,7 +2248,13 @@ uint8_t SVM40::SHDLC_SerialToBuffer() {
                     /* if a board can not handle 115K you get uncontrolled input
                      * that can result in short / wrong messages
                      */
-                    if (_Receive_BUF_Length < 3) return(ERR_PROTOCOL);
+                    if (_Receive_BUF_Length < 6) return(ERR_PROTOCOL);
+
+                    // buffer : hdr addr cmd state length data....data crc hdr
+                    if (_Receive_BUF_Length != _Receive_BUF[4] + 6) {
+                        DebugPrintf("Length %d does not match received bytes\n", _Receive_BUF[4]);
+                        return(ERR_PROTOCOL);
+                    }
 
                     return(ERR_OK);
                 }
@@ -1396,7 +2262,7 @@ uint8_t SVM40::SHDLC_SerialToBuffer() {
 
             i++;
 
-            if(i > MAXRECVBUFLENGTH)
+            if(i >= MAXRECVBUFLENGTH)
             {
                 DebugPrintf("\nReceive buffer full\n");
                 return(ERR_PROTOCOL);
@@ -1404,12 +2270,15 @@ uint8_t SVM40::SHDLC_SerialToBuffer() {
         }
 
         // prevent deadlock
-        if (millis() - startTime > TIME_OUT)
+        if (millis() - startTime > timeout)
         {
             if ( _SVM40_Debug > 1)
                 DebugPrintf("TimeOut during reading byte %d\n", i);
-            return(ERR_TIMEOUT);
+            return(timeout < TIME_OUT ? ERR_DEADLINE : ERR_TIMEOUT);
         }
+
+        // nothing received : wait for the next byte (if wait routine)
+        if (_wait) Wait(1);
     }
 }
 
@@ -1474,26 +2343,40 @@ void SVM40::I2C_fill_buffer(uint16_t cmd,  uint8_t len, uint8_t *param) {
  * Ok ERR_OK else error
  */
 uint8_t SVM40::I2C_SendToSVM() {
+    uint8_t ret;
 
     if (_Send_BUF_Length == 0) return(ERR_DATALENGTH);
 
+    // sensor busy with start / reset, time budget
+    ret = WaitReady();
+    if (ret != ERR_OK) return(ret);
+
     if (_SVM40_Debug) {
         DebugPrintf("Sending ");
         for(byte i = 0; i < _Send_BUF_Length; i++)
             DebugPrintf("0x%02X ", _Send_BUF[i]);
         DebugPrintf("\n");
     }
-DebugPrintf("begin");
+    // hold a shared bus for the write only
+    if (_bus) _bus->Acquire();
+
     _i2cPort->beginTransmission(SVM40_I2C_ADDRESS);
-DebugPrintf("write");
     _i2cPort->write(_Send_BUF, _Send_BUF_Length);
-DebugPrintf("end");
-    if ( _i2cPort->endTransmission() != 0) return ERR_PROTOCOL;
-DebugPrintf("done");
+
+    if (_trace) _trace(_trace_arg, SVM40_TRACE_TX, _Send_BUF, _Send_BUF_Length);
+    _stats.bytes_tx += _Send_BUF_Length;
+
+    if ( _i2cPort->endTransmission() != 0) {
+        if (_bus) _bus->Release();
+        _stats.protocol_errors++;
+        return ERR_PROTOCOL;
+    }
+
+    if (_bus) _bus->Release();
     _Send_BUF_Length = 0;
 
-    // give time to act on request
-    delay(_RespDelay);
+    // give time to act on request (the bus is free for others)
+    Wait(_RespDelay);
 
     return(ERR_OK);
 }
@@ -1536,54 +2419,101 @@ uint8_t SVM40::I2C_RequestFromSVM(uint8_t cnt, bool chk_zero) {
  * @brief       : receive from Sensor
  * @param count :    number of data bytes to expect
  * @param chk_zero : check for zero termination ( Serial and product code)
+ *
+ * A shared bus is held until the answer is read from the Wire buffer.
+ *
+ * @return :
+ * OK   ERR_OK else error
+ */
+uint8_t SVM40::I2C_ReadFromSVM(uint8_t count, bool chk_zero) {
+    uint8_t ret;
+
+    if (_bus == NULL) return(I2C_ReadBus(count, chk_zero));
+
+    _bus->Acquire();
+    ret = I2C_ReadBus(count, chk_zero);
+    _bus->Release();
+
+    return(ret);
+}
+
+/**
+ * @brief       : read answer from the bus
+ * @param count :    number of data bytes to expect
+ * @param chk_zero : check for zero termination ( Serial and product code)
  *  false : expect and read all the data bytes
  *  true  : expect NULL termination and count is MAXIMUM data bytes
  *
  * @return :
  * OK   ERR_OK else error
  */
-uint8_t SVM40::I2C_ReadFromSVM(uint8_t count, bool chk_zero) {
+uint8_t SVM40::I2C_ReadBus(uint8_t count, bool chk_zero) {
     uint8_t data[3];
     uint8_t i, j;
+    uint16_t left, chunk;
+    const uint16_t max_chunk = SVM40_I2C_BUFFER / 3 * 3;
 
     j = i = _Receive_BUF_Length = 0;
 
+    if (count > MAXRECVBUFLENGTH) count = MAXRECVBUFLENGTH;
+
     // 2 data bytes  + crc
-    _i2cPort->requestFrom((uint8_t) SVM40_I2C_ADDRESS, uint8_t (count / 2 * 3));
+    left = (uint16_t) count / 2 * 3;
 
-    while (_i2cPort->available()) {
+    // read in parts that fit the Wire buffer, each a whole number of
+    // words (2 data bytes + CRC). This assumes the SVM40 continues its
+    // answer on the next read : NOT validated on hardware. An answer that
+    // fits the buffer is read at once
+    while (left > 0 && _Receive_BUF_Length < count) {
 
-        data[i++] = _i2cPort->read();
+        chunk = left > max_chunk ? max_chunk : left;
+        _i2cPort->requestFrom((uint8_t) SVM40_I2C_ADDRESS, (uint8_t) chunk);
 
-        DebugPrintf("data 0x%02X\n", data[i-1]);
+        // do not read more than requested, whatever available() says
+        while (chunk > 0 && _i2cPort->available()) {
 
-        // 2 bytes data, 1 CRC
-        if( i == 3) {
+            chunk--;
+            left--;
 
-            if (data[2] != I2C_calc_CRC(&data[0])){
-                DebugPrintf("I2C CRC error: got 0x%02X, calculated 0x%02X\n",data[2] & 0xff,I2C_calc_CRC(&data[0]) &0xff);
-                return(ERR_PROTOCOL);
-            }
+            data[i++] = _i2cPort->read();
 
-            _Receive_BUF[_Receive_BUF_Length++] = data[0];
-            _Receive_BUF[_Receive_BUF_Length++] = data[1];
+            if (_trace) _trace(_trace_arg, SVM40_TRACE_RX, &data[i-1], 1);
+            _stats.bytes_rx++;
 
-            i = 0;
+            DebugPrintf("data 0x%02X\n", data[i-1]);
 
-            // check for zero termination (Serial and product code)
-            if (chk_zero) {
+            // 2 bytes data, 1 CRC
+            if( i == 3) {
 
-                if (data[0] == 0 && data[1] == 0) {
+                if (data[2] != I2C_calc_CRC(&data[0])){
+                    DebugPrintf("I2C CRC error: got 0x%02X, calculated 0x%02X\n",data[2] & 0xff,I2C_calc_CRC(&data[0]) &0xff);
+                    _stats.crc_errors++;
+                    return(ERR_PROTOCOL);
+                }
 
-                    // flush any bytes pending (added as the Apollo 2.0.1 was NOT clearing Wire rxBuffer)
-                    // Logged as an issue and expect this could be removed in the future
-                    while (_i2cPort->available()) _i2cPort->read();
-                    return(ERR_OK);
+                _Receive_BUF[_Receive_BUF_Length++] = data[0];
+                _Receive_BUF[_Receive_BUF_Length++] = data[1];
+
+                i = 0;
+
+                // check for zero termination (Serial and product code)
+                if (chk_zero) {
+
+                    if (data[0] == 0 && data[1] == 0) {
+
+                        // flush any bytes pending (added as the Apollo 2.0.1 was NOT clearing Wire rxBuffer)
+                        // Logged as an issue and expect this could be removed in the future
+                        while (_i2cPort->available()) _i2cPort->read();
+                        _stats.frames_ok++;
+                        return(ERR_OK);
+                    }
                 }
-            }
 
-            if (_Receive_BUF_Length >= count) break;
+                if (_Receive_BUF_Length >= count) break;
+            }
         }
+
+        if (chunk > 0) break;           // sensor has no more bytes
     }
 
     if (i != 0) {
@@ -1593,12 +2523,17 @@ uint8_t SVM40::I2C_ReadFromSVM(uint8_t count, bool chk_zero) {
 
     if (_Receive_BUF_Length == 0) {
         DebugPrintf("Error: Received NO bytes\n");
+        _stats.protocol_errors++;
         return(ERR_PROTOCOL);
     }
 
-    if (_Receive_BUF_Length == count) return(ERR_OK);
+    if (_Receive_BUF_Length == count) {
+        _stats.frames_ok++;
+        return(ERR_OK);
+    }
 
     DebugPrintf("Error: Expected bytes : %d, Received bytes %d\n", count,_Receive_BUF_Length);
+    _stats.protocol_errors++;
 
     return(ERR_DATALENGTH);
 }
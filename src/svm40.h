@@ -46,13 +46,37 @@
  * Version 2.1 / october 2023 / paulvha
  *  - fixed setVocState in I2C
  *
+ * Version 2.2 / October 2026 / paulvha
+ *  - added GetRawValues() / DecodeValues() and sample history (svm40_history.h)
+ *  - added window aggregation (svm40_stats.h)
+ *  - added report-by-exception filter (svm40_filter.h)
+ *  - added threshold / event engine (svm40_event.h)
+ *  - added VOC index algorithm (svm40_voc_algorithm.h)
+ *  - added SetTrace() and bus capture / replay (svm40_capture.h)
+ *  - added GetStats() communication statistics
+ *  - UART : discard bytes left from an earlier answer before sending a command
+ *  - hardened receive : buffer bound, frame length and stuffing checked, I2C
+ *    reads limited to request, device info limited to received bytes
+ *  - added SVM40_MINIMAL profile, SVM40_NO_I2C / SVM40_NO_UART build flags
+ *  - added SetLock() for use from several tasks / threads
+ *  - added begin(SVM40_Bus *) for a Wire bus shared with other tasks
+ *  - I2C answers longer than the Wire buffer are read in parts (SVM40_I2C_BUFFER)
+ *  - added beginConfig() / Stage*() / commit() : one stop / start for all settings
+ *  - added svm40_config and syncConfig() : write only what differs
+ *  - added reboot detection and recovery (SetRebootRecovery(), GetReboots())
+ *  - added discover() : device identity and capabilities read once and cached
+ *  - added port auto-detection (svm40_detect.h)
+ *  - start() / reset() return at once, the wait is done by the next command (IsReady())
+ *  - added SetBudget() / Within() : time budget per call (ERR_DEADLINE)
+ *  - added SetWait() : pluggable wait (yield, RTOS, sleep), time waited in GetStats()
+ *  - added duty-cycled acquisition (svm40_scheduler.h)
+ *
  *********************************************************************
  */
 #ifndef SVM40_H
 #define SVM40_H
 
 #include "Arduino.h"            // Needed for Stream
-#include "printf.h"             // for debug
 #include "Wire.h"               // for I2c
 
 /**
@@ -63,15 +87,39 @@
 
 /**
  * To EXCLUDE I2C communication, maybe for resource reasons,
- * comment out the line below.
+ * comment out the line below (or compile with -DSVM40_NO_I2C)
  */
+#ifndef SVM40_NO_I2C
 #define INCLUDE_I2C   1
+#endif
 
 /**
  * To EXCLUDE the serial communication, maybe for resource reasons
  * as your board does not have a seperate serial, comment out the line below
+ * (or compile with -DSVM40_NO_UART)
  */
+#ifndef SVM40_NO_UART
 #define INCLUDE_UART 1
+#endif
+
+/**
+ * For the smallest footprint (e.g. on an UNO) remove the comment on the
+ * line below (or compile with -DSVM40_MINIMAL) :
+ *  - no debug messages, EnableDebugging() has no effect (SVM40_NO_DEBUG)
+ *  - the send / receive buffers are shared by all SVM40 instances
+ *  - printf.h is not included
+ *
+ * extras/size/size_report.sh shows the flash / RAM use of each option.
+ */
+//#define SVM40_MINIMAL 1
+
+#if defined SVM40_MINIMAL && !defined SVM40_NO_DEBUG
+#define SVM40_NO_DEBUG 1
+#endif
+
+#ifndef SVM40_MINIMAL
+#include "printf.h"             // for debug
+#endif
 
 /**
  * select debug serial
@@ -106,6 +154,39 @@ struct svm40_values
     float      absolute_hum;       // calculated absolute humidity in g/m3.
 };
 
+// channels of svm40_values to use in aggregation, filter etc.
+enum svm40_channel {
+    SVM40_CH_TEMPERATURE = 0,
+    SVM40_CH_HUMIDITY = 1,
+    SVM40_CH_VOC_INDEX = 2,
+    SVM40_CH_RAW_VOC = 3,
+    SVM40_CH_COUNT = 4,             // number of channels above
+
+    // calculated values (only for SVM40_Events)
+    SVM40_CH_HEAT_INDEX = 10,
+    SVM40_CH_DEW_POINT = 11,
+    SVM40_CH_DEW_SPREAD = 12,       // temperature - dew point (condensation risk if low)
+    SVM40_CH_ABS_HUMIDITY = 13
+};
+
+/**
+ * @brief : get the value of a channel
+ * @param v  : pointer to measurement values
+ * @param ch : channel to obtain
+ */
+float svm40_channel_value(struct svm40_values *v, svm40_channel ch);
+
+// structure with the measurement values as received from the sensor (12 bytes)
+struct svm40_raw
+{
+    uint16_t   VOC_index;          // VOC index scaled by 10
+    int16_t    humidity;           // Compensated humidity in % RH scaled by 100
+    int16_t    temperature;        // Compensated temperature in degrees celsius scaled by 200
+    uint16_t   raw_voc_ticks;      // Raw VOC output ticks as read from the SGP sensor
+    int16_t    raw_humidity;       // Uncompensated humidity in % RH scaled by 100
+    int16_t    raw_temperature;    // Uncompensated temperature in degrees celsius scaled by 200
+};
+
 // VOC parameters
 struct svm_algopar {
 
@@ -149,14 +230,40 @@ struct SVM40_version {
 #define ERR_CMDSTATE    0x43
 #define ERR_TIMEOUT     0x50
 #define ERR_PROTOCOL    0x51
+#define ERR_FIRMWARE    0x52            // not the firmware expected (syncConfig())
+#define ERR_NOTREADY    0x53            // sensor busy after start / reset (SetReadyWait())
+#define ERR_DEADLINE    0x54            // time budget can not be met (SetBudget())
 
 // wait times (mS) after sending command to sensor
 #define RX_DELAY_MS     100                 // wait between write and read
+#define START_DELAY_MS  1000                // sensor ready after start
+#define RESET_DELAY_MS  2000                // sensor ready after reset
 #define MAXRECVBUFLENGTH 50
+#define SHDLC_MAX_DATA   8                  // data bytes in a command
+#define MAXSENDBUFLENGTH (2 * (SHDLC_MAX_DATA + 5) + 2) // all stuffed + start / stop
 
 // I2C / WIRE
 #define SVM40_I2C_ADDRESS       0x6A            // I2C address
 
+/**
+ * Size of the Wire receive buffer. An answer that is longer (e.g. the
+ * serial number : 36 bytes) is read in parts of up to this size, rounded
+ * down to whole words of 3 bytes. This assumes the SVM40 continues the
+ * answer over separate reads, which is NOT validated on hardware : if
+ * possible use a Wire buffer that holds the longest answer (36 bytes).
+ * Detected from the Wire library, else 32 (as on AVR). Can be set with
+ * -DSVM40_I2C_BUFFER=
+ */
+#ifndef SVM40_I2C_BUFFER
+#if defined I2C_BUFFER_LENGTH                   // e.g. ESP32
+#define SVM40_I2C_BUFFER        I2C_BUFFER_LENGTH
+#elif defined BUFFER_LENGTH                     // e.g. AVR, SAMD
+#define SVM40_I2C_BUFFER        BUFFER_LENGTH
+#else
+#define SVM40_I2C_BUFFER        32
+#endif
+#endif
+
 #define SVM40_I2C_RESET              0xD304     // .Reset SVM40
 #define SVM40_I2C_START_MEASURE      0x0010     // .Starts continuous measurement in polling mode.
 #define SVM40_I2C_STOP_MEASURE       0x0104     // .Stop the measurement mode and returns to the idle mode.
@@ -210,6 +317,8 @@ struct SVM40_version {
 
 #define SHDLC_IND   0x7e                        // header & trailer
 #define TIME_OUT    5000                        // timeout to prevent deadlock read
+#define SVM40_NO_DEADLINE 0xffffffff            // no time budget (SetBudget())
+#define SVM40_REBOOT_MARGIN 5                    // seconds, uptime less than since start() (UART)
 
 
 /* state byte data (only in SERIAL)
@@ -251,8 +360,133 @@ enum svm40_comms_port {
     NONE = 3
 };
 
+/**
+ * trace of all bytes sent to and received from the sensor
+ * @param arg  : as provided with SetTrace()
+ * @param dir  : SVM40_TRACE_TX (to sensor) or SVM40_TRACE_RX (from sensor)
+ * @param data : bytes as on the bus (UART : before unstuffing, I2C : including CRC)
+ * @param len  : number of bytes
+ */
+#define SVM40_TRACE_TX 0
+#define SVM40_TRACE_RX 1
+typedef void (*svm40_trace_cb)(void *arg, uint8_t dir, const uint8_t *data, uint8_t len);
+
+// settings staged for commit() (beginConfig())
+#define SVM40_CFG_TUNING    0x01
+#define SVM40_CFG_OFFSET    0x02
+#define SVM40_CFG_STATE     0x04
+
+/**
+ * device configuration for syncConfig(), e.g. kept in EEPROM.
+ * Seal with SealConfig() after a change (sets version and crc).
+ * The bytes up to and including crc are at the same place on all
+ * platforms (15 bytes). sizeof() is 15 on AVR and 16 on ARM / x86 (a
+ * padding byte after crc). The VOC state is not part of it, see
+ * svm40_checkpoint.h.
+ */
+#define SVM40_CONFIG_VERSION 2
+
+struct svm40_config
+{
+    uint8_t    version;            // SVM40_CONFIG_VERSION
+    uint8_t    flags;              // SVM40_CFG_OFFSET / SVM40_CFG_TUNING : settings to sync
+    int16_t    temp_offset;        // degrees celsius (SVM40_CFG_OFFSET)
+    struct svm_algopar tuning;     // SVM40_CFG_TUNING
+    uint8_t    fw_major;           // expected firmware (0 = any)
+    uint8_t    fw_minor;
+    uint8_t    crc;                // CRC-8 of the bytes before
+};
+
+// syncConfig() report : SVM40_CFG_* written and
+#define SVM40_SYNC_STORED   0x08   // StoreNvData() was called
+#define SVM40_SYNC_FW       0x10   // firmware is not as expected
+
+// capabilities of the sensor on the transport used (svm40_device_info)
+#define SVM40_CAP_UPTIME        0x01   // GetSystemUpTime()
+#define SVM40_CAP_PRODUCT_NAME  0x02   // GetProductName()
+#define SVM40_CAP_PRODUCT_TYPE  0x04   // GetProductType()
+#define SVM40_CAP_OFFSET_FLOAT  0x08   // temperature offset sent as float (firmware 1.x)
+
+#define SVM40_INFO_LEN  32
+
+/**
+ * device identity as read once by discover(). It does not change while
+ * the sensor is connected, also not after a reset or reboot.
+ * Not supported items contain "Not Supported".
+ */
+struct svm40_device_info
+{
+    struct SVM40_version version;
+    char       serial[SVM40_INFO_LEN];
+    char       product_name[SVM40_INFO_LEN];
+    char       product_type[SVM40_INFO_LEN];
+    uint8_t    caps;               // SVM40_CAP_*
+};
+
+// communication statistics
+struct svm40_stats
+{
+    uint32_t   frames_ok;          // answers received without error
+    uint32_t   crc_errors;         // answers with CRC error
+    uint32_t   timeouts;           // no (complete) answer in time (UART only)
+    uint32_t   protocol_errors;    // wrong header / length / stuffing or I2C NACK
+    uint32_t   bytes_tx;           // bytes sent
+    uint32_t   bytes_rx;           // bytes received
+    uint32_t   wait_us;            // time in waits (clear at least every hour)
+};
+
+/**
+ * lock / unlock an SVM40 instance that is used from several tasks
+ * @param arg  : as provided with SetLock()
+ * @param lock : true = lock, false = unlock
+ *
+ * The lock MUST be recursive as a call can make other calls on the
+ * instance (e.g. GetValues() calls start()). For example a FreeRTOS
+ * xSemaphoreCreateRecursiveMutex() or a std::recursive_mutex.
+ */
+typedef void (*svm40_lock_cb)(void *arg, bool lock);
+
+/**
+ * wait routine (SetWait()), called instead of delay() when the driver waits
+ * for the sensor and while it waits for bytes on the serial port.
+ * @param arg : as provided with SetWait()
+ * @param ms  : mS to wait. Returning earlier is allowed (e.g. on the
+ *              interrupt of a received byte), the driver checks the time
+ *
+ * Examples :
+ *   svm40_wait_yield                            call yield() meanwhile
+ *   vTaskDelay(pdMS_TO_TICKS(ms))               FreeRTOS, other tasks run
+ *   __WFI() until millis() - st >= ms           sleep until an interrupt
+ *   poll(&fd, 1, ms)                            host, wake on serial input
+ */
+typedef void (*svm40_wait_cb)(void *arg, uint32_t ms);
+
+void svm40_wait_yield(void *arg, uint32_t ms);
+
+class SVM40_Bus;                // svm40_bus.h
+
+/**
+ * called after a reboot of the sensor was detected, before the measurement
+ * is restarted (e.g. to restore the VOC state, see svm40_checkpoint.h)
+ * @param arg : as provided with SetRebootHandler()
+ */
+typedef void (*svm40_reboot_cb)(void *arg);
+
 /***************************************************************/
 
+/**
+ * Thread safety
+ *
+ * All state is kept in the SVM40 instance, so different instances can be
+ * used from different tasks / threads at the same time, as long as they do
+ * not share a Serial port or Wire bus. For a Wire bus that is shared with
+ * other devices / tasks use begin(SVM40_Bus *) (see svm40_bus.h).
+ * Exception : with SVM40_MINIMAL the buffers are shared by all instances.
+ *
+ * If one instance is used from several tasks, set a lock with SetLock().
+ * It is held for the duration of each call that communicates with the
+ * sensor.
+ */
 class SVM40
 {
   public:
@@ -273,6 +507,43 @@ class SVM40
     */
     void EnableDebugging(uint8_t act, debug_serial SelectDebugSerial = STANDARD);
 
+    /**
+     * @brief : call a routine with every byte sent and received
+     * @param cb  : routine to call (NULL to stop)
+     * @param arg : passed to the routine
+     *
+     * Used by SVM40_Capture (svm40_capture.h).
+     */
+    void SetTrace(svm40_trace_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : set a routine to lock / unlock the instance
+     * @param cb  : routine to call (NULL = no locking)
+     * @param arg : passed to the routine
+     *
+     * Needed only if the instance is used from several tasks / threads.
+     * The lock must be recursive (see svm40_lock_cb)
+     */
+    void SetLock(svm40_lock_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : set how the driver waits (see svm40_wait_cb)
+     * @param cb  : routine to call (NULL = delay(), default)
+     * @param arg : passed to the routine
+     *
+     * Most of the time of a command is waiting for the answer (100mS or
+     * more). With a routine that sleeps or lets other tasks run, that time
+     * is not spent in the CPU. The time waited is in GetStats() (wait_us).
+     */
+    void SetWait(svm40_wait_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : get / clear the communication statistics
+     * @param s : pointer to structure to store
+     */
+    void GetStats(struct svm40_stats *s) {*s = _stats;}
+    void ClearStats() {memset(&_stats, 0, sizeof(_stats));}
+
     /**
      * @brief Manual assigment of the serial communication port
      * @param serialPort: serial communication port to use
@@ -296,6 +567,17 @@ class SVM40
      */
     bool begin(TwoWire *wirePort);
 
+    /**
+     * @brief Assigment of a shared I2C bus (see svm40_bus.h)
+     * @param bus : arbiter of the shared Wire port
+     *
+     * The bus is only held while writing a command and reading the
+     * answer, not during the wait in between.
+     * @return :
+     *   true on success else false
+     */
+    bool begin(SVM40_Bus *bus);
+
     /**
      * @brief check if SVM40 sensors are available (read ID)
      *
@@ -304,8 +586,39 @@ class SVM40
      */
     bool probe();
 
+    /**
+     * @brief : read the device identity and capabilities once
+     * @param d : structure to hold the information
+     *
+     * Reads version, serial number, product name and type (only what the
+     * transport supports) and keeps a pointer to d. Afterwards GetVersion(),
+     * GetSerialNumber(), GetProductName(), GetProductType() and the
+     * temperature offset format are answered from d, without bus traffic.
+     * d must stay available (e.g. global) as long as the driver is used.
+     *
+     * Call again after connecting another sensor.
+     *
+     * @return :
+     *  ERR_OK = ok else error (nothing cached)
+     */
+    uint8_t discover(struct svm40_device_info *d);
+
+    /**
+     * @brief : get the information cached by discover()
+     *
+     * @return :
+     *  pointer to the information or NULL if discover() was not done
+     */
+    const struct svm40_device_info *GetDeviceInfo() {return(_info);}
+
     /**
      * @brief : Perform SVM40 instructions
+     *
+     * After start() the sensor needs START_DELAY_MS and after reset()
+     * RESET_DELAY_MS before the next command. These return at once and
+     * the next command waits the time that is left (see SetReadyWait()),
+     * so other initialisation can be done meanwhile.
+     *
      * @return :
      *   true on success else false
      */
@@ -313,10 +626,54 @@ class SVM40
     bool start() {return(Instruct(SVM40_SHDLC_START_MEASURE));}
     bool stop()  {return(Instruct(SVM40_SHDLC_STOP_MEASURE));}
 
+    /**
+     * @brief : is the sensor ready after start() / reset()
+     *
+     * GetReadyIn() returns the mS left before it is ready (0 = ready)
+     */
+    bool     IsReady() {return(GetReadyIn() == 0);}
+    uint32_t GetReadyIn();
+
+    /**
+     * @brief : set what a command does before the sensor is ready
+     * @param act :
+     *  true  : wait the time that is left (default)
+     *  false : return ERR_NOTREADY at once (or false)
+     */
+    void SetReadyWait(bool act) {_ready_wait = act;}
+
+    /**
+     * @brief : limit the time a call may take
+     * @param ms : budget in mS for each call (0 = no limit, default)
+     *
+     * The budget starts when a call is made and covers the wait for the
+     * sensor to be ready, the wait for the answer and the reading of it.
+     * If the budget can not be met the call returns ERR_DEADLINE (or false)
+     * as soon as that is known. A command is not sent if the answer can
+     * not be there in time. The wait for a shared bus (SVM40_Bus) is not
+     * limited.
+     *
+     * Within() sets the budget for the next call only :
+     *
+     *   ret = svm40.Within(200).GetValues(&v);
+     *
+     * Within() is set outside the lock (SetLock()), so the call of an
+     * other task can take it. Use it only if the instance is used from a
+     * single task, else use SetBudget().
+     *
+     * A call that stops the measurement to change a setting (Set*(),
+     * commit(), syncConfig()) always restores and restarts, even past the
+     * budget, so the sensor is not left idle.
+     */
+    void   SetBudget(uint32_t ms) {_budget = ms;}
+    SVM40& Within(uint32_t ms)    {_budget_once = ms; return(*this);}
+
     /**
      * @brief : retrieve software/hardware version information from the SVM40
      * @param : pointer to structure to store
      *
+     * After discover() the cached version is returned.
+     *
      * @return :
      *  ERR_OK = ok else error
      */
@@ -339,6 +696,8 @@ class SVM40
      * @param ser: buffer store info
      * @param len: Max data to store in buffer
      *
+     * After discover() the cached information is returned.
+     *
      * @return :
      *  ERR_OK = ok else error
      */
@@ -357,6 +716,55 @@ class SVM40
      */
     uint8_t GetValues(struct svm40_values *v);
 
+    /**
+     * @brief : read all values from the sensor as received (no conversion)
+     * @param : pointer to structure to store
+     *
+     * The result is only 12 bytes and can be kept (e.g. in SVM40_History)
+     * and translated later with DecodeValues().
+     *
+     * @return :
+     *  ERR_OK = ok else error
+     */
+    uint8_t GetRawValues(struct svm40_raw *r);
+
+    /**
+     * @brief : recover after a reboot of the sensor (e.g. brown out)
+     * @param act : true = enable (default), false = disable
+     * @param c   : configuration to restore with syncConfig() (NULL = none)
+     *
+     * After a reboot the sensor is idle and GetValues() / GetRawValues()
+     * fail. When enabled, the driver then checks whether the sensor is
+     * idle, restores the configuration (not stored), calls the reboot
+     * handler and restarts the measurement, and tries the read again.
+     * The VOC state in c is NOT restored, as it can be older than the
+     * 10 minutes allowed. The learning of the VOC algorithm starts again,
+     * unless the handler restores a recent VOC state (svm40_checkpoint.h).
+     */
+    void SetRebootRecovery(bool act, struct svm40_config *c = NULL);
+
+    /**
+     * @brief : set routine to call after a reboot was detected
+     * @param cb  : routine to call (NULL = none)
+     * @param arg : passed to the routine
+     */
+    void SetRebootHandler(svm40_reboot_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : number of sensor reboots detected
+     */
+    uint16_t GetReboots() {return(_reboots);}
+
+    /**
+     * @brief : translate raw values to measurement values
+     * @param r : pointer to raw values (as from GetRawValues())
+     * @param v : pointer to structure to store
+     *
+     * Derived values (heat index, dew point, absolute humidity) are
+     * calculated and the temperature setting of SetTempCelsius() is applied.
+     */
+    void DecodeValues(struct svm40_raw *r, struct svm40_values *v);
+
     /**
      * @brief : read VOC algorithm state from the sensor and store in array
      * @param : pointer to array to store
@@ -458,6 +866,61 @@ class SVM40
      */
     uint8_t StoreNvData();
 
+    /**
+     * @brief : configuration transaction
+     *
+     * Each Set* call stops and restarts the measurement (start() waits a
+     * second). To apply more settings at once, stage them and commit :
+     *
+     *   svm40.beginConfig();
+     *   svm40.StageTemperatureOffset(2);
+     *   svm40.StageVocTuningParameters(&p);
+     *   ret = svm40.commit(true);           // true = also StoreNvData()
+     *
+     * commit() stops the measurement once, writes all staged settings,
+     * optionally stores them and restarts the measurement (if it was
+     * started). If a write fails, the settings already written are
+     * restored. The staged settings are cleared by commit().
+     *
+     * @return commit() :
+     *  ERR_OK = ok else error of the first write that failed
+     */
+    void beginConfig();
+    void StageVocTuningParameters(struct svm_algopar *p);
+    void StageTemperatureOffset(int16_t val);
+    void StageVocState(uint8_t *p);
+    uint8_t commit(bool store = false);
+
+    /**
+     * @brief : bring the sensor in line with a configuration
+     * @param c      : configuration (sealed with SealConfig())
+     * @param report : if not NULL, set to what was done :
+     *                 SVM40_CFG_* written, SVM40_SYNC_STORED, SVM40_SYNC_FW
+     * @param store  : store changed offset / tuning in non-volatile memory
+     *
+     * The offset and tuning are read from the sensor and only written if
+     * they differ. StoreNvData() (750mS and wear of the non-volatile
+     * memory) is only called if one of them was written. All writes are
+     * done with one commit() (see beginConfig()).
+     *
+     * @return :
+     *  ERR_OK = ok
+     *  ERR_PARAMETER : configuration version or crc is wrong
+     *  ERR_FIRMWARE  : firmware is not as expected, nothing written
+     *  else error
+     */
+    uint8_t syncConfig(struct svm40_config *c, uint8_t *report = NULL, bool store = true);
+
+    /**
+     * @brief : set version and crc of a configuration / check them
+     * @param c : configuration
+     *
+     * @return CheckConfig() :
+     *  true if version and crc are correct
+     */
+    void SealConfig(struct svm40_config *c);
+    bool CheckConfig(struct svm40_config *c);
+
     /**
      * @brief : Set temperature values to return in Getvalues().
      * @param act :
@@ -469,9 +932,33 @@ class SVM40
 
   private:
 
+    friend class SVM40_Bench;           // host benchmark (extras/bench)
+
+    // holds the lock (SetLock()) for the duration of a call and starts
+    // the time budget (SetBudget()) of the outer call
+    class Guard
+    {
+      public:
+        Guard(SVM40 *s) : _s(s) {
+            if (_s->_lock) _s->_lock(_s->_lock_arg, true);
+            if (_s->_depth++ == 0) _s->StartBudget();
+        }
+        ~Guard() {
+            _s->_depth--;
+            if (_s->_lock) _s->_lock(_s->_lock_arg, false);
+        }
+      private:
+        SVM40 *_s;
+    };
+
     /** shared variables */
+#if defined SVM40_MINIMAL
+    static uint8_t _Receive_BUF[MAXRECVBUFLENGTH]; // buffers (all instances)
+    static uint8_t _Send_BUF[MAXSENDBUFLENGTH];
+#else
     uint8_t _Receive_BUF[MAXRECVBUFLENGTH]; // buffers
-    uint8_t _Send_BUF[20];
+    uint8_t _Send_BUF[MAXSENDBUFLENGTH];
+#endif
     uint8_t _Receive_BUF_Length;
     uint8_t _Send_BUF_Length;
 
@@ -482,9 +969,59 @@ class SVM40
     uint8_t       _SVM40_Debug;         // program debug level
     uint8_t       _FW_major;            // firmware level
     uint8_t       _FW_minor;            // firmware level
+    struct svm40_device_info *_info;    // cached by discover() (or NULL)
     unsigned long _RespDelay;           // delay after sending command
+    svm40_trace_cb _trace;              // trace bytes on the bus
+    void          *_trace_arg;
+    struct svm40_stats _stats;          // communication statistics
+    svm40_lock_cb _lock;                // lock for use from several tasks
+    void          *_lock_arg;
+    svm40_wait_cb _wait;                // wait routine (NULL = delay())
+    void          *_wait_arg;
+
+    // reboot detection
+    bool          _recover;             // recover after reboot
+    uint16_t      _reboots;             // reboots detected
+    uint32_t      _start_ms;            // millis() of start()
+
+    // ready after start / reset
+    bool          _ready_pending;       // _ready_at is in the future
+    uint32_t      _ready_at;            // millis() the sensor is ready
+    bool          _ready_wait;          // wait for ready (else ERR_NOTREADY)
+    uint8_t       _instr_err;           // error of the last failed Instruct()
+
+    // time budget per call
+    uint32_t      _budget;              // mS for each call (0 = none)
+    uint32_t      _budget_once;         // mS for the next call (0 = _budget)
+    bool          _deadline_set;        // current call has a deadline
+    uint32_t      _deadline;            // millis() the current call must end
+    uint8_t       _depth;               // nested calls (Guard)
+    struct svm40_config *_reboot_cfg;   // configuration to restore
+    svm40_reboot_cb _reboot_cb;         // called after a reboot
+    void          *_reboot_arg;
+
+    // configuration transaction (beginConfig())
+    uint8_t       _cfg_staged;          // SVM40_CFG_* staged
+    struct svm_algopar _cfg_tuning;
+    int16_t       _cfg_offset;
+    uint8_t       _cfg_state[8];
 
     /** supporting routines */
+    uint8_t  ReadVersion(SVM40_version *v);
+    uint8_t  WaitReady();
+    uint8_t  StopIdle();
+    void     Wait(uint32_t ms);
+    void     StartBudget();
+    uint32_t TimeLeft();
+    void     SetReadyAt(uint32_t ms);
+    uint8_t  ReadVocTuning(struct svm_algopar *p);
+    uint8_t  ReadRaw(struct svm40_raw *r);
+    bool     CheckReboot(uint8_t ret);
+    bool     Recover();
+    uint8_t  WriteVocTuning(struct svm_algopar *p);
+    uint8_t  WriteTemperatureOffset(int16_t val);
+    uint8_t  WriteVocState(uint8_t *p);
+    uint8_t  ConfigCRC(struct svm40_config *c);
     void     DebugPrintf(const char *pcFmt, ...);
     uint16_t byte_to_uint16(int x);
     float    byte_to_float(int x);
@@ -519,11 +1056,13 @@ class SVM40
     void    I2C_fill_buffer(uint16_t cmd, uint8_t len = 0,  uint8_t *param = NULL);
     uint8_t I2C_RequestFromSVM(uint8_t count, bool chk_zero = false);
     uint8_t I2C_ReadFromSVM(uint8_t cnt, bool chk_zero);
+    uint8_t I2C_ReadBus(uint8_t cnt, bool chk_zero);
     uint8_t I2C_SendToSVM();
     uint8_t I2C_calc_CRC(uint8_t data[2]);
 
     // variables
     TwoWire *_i2cPort;      // holds the I2C port
+    SVM40_Bus *_bus;        // arbiter if the bus is shared (else NULL)
 #endif // INCLUDE_I2C
 };
 
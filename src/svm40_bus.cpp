@@ -0,0 +1,143 @@
+/**
+ * SVM40 Library shared I2C bus arbiter
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_bus.h"
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Bus::SVM40_Bus(TwoWire *wire) {
+    _wire = wire;
+    _lock = NULL;
+    _lock_arg = NULL;
+    _next = _serving = 0;
+    _held = 0;
+    ClearStats();
+}
+
+/**
+ * @brief : set a lock to protect the ticket counters
+ */
+void SVM40_Bus::SetLock(svm40_lock_cb cb, void *arg) {
+    _lock = cb;
+    _lock_arg = arg;
+}
+
+/**
+ * @brief : wait for the bus (in order of request) and hold it
+ */
+void SVM40_Bus::Acquire() {
+    uint32_t start, wait;
+    uint16_t ticket, queue;
+    bool mine;
+
+    start = micros();
+
+    Lock();
+    ticket = _next++;
+    queue = _next - _serving;
+    if (queue > _stats.queue_max) _stats.queue_max = queue;
+    mine = (_serving == ticket);
+    Unlock();
+
+    while (! mine) {
+        yield();
+        Lock();
+        mine = (_serving == ticket);
+        Unlock();
+    }
+
+    _held = micros();
+    wait = _held - start;
+
+    Lock();
+    _stats.transactions++;
+    _stats.wait_us += wait;
+    if (wait > _stats.wait_max_us) _stats.wait_max_us = wait;
+    Unlock();
+}
+
+/**
+ * @brief : release the bus for the next task waiting
+ */
+void SVM40_Bus::Release() {
+    uint32_t hold = micros() - _held;
+
+    Lock();
+    _stats.busy_us += hold;
+    if (hold > _stats.hold_max_us) _stats.hold_max_us = hold;
+    _serving++;
+    Unlock();
+}
+
+/**
+ * @brief : number of tasks waiting for the bus
+ */
+uint16_t SVM40_Bus::Waiting() {
+    uint16_t queue;
+
+    Lock();
+    queue = _next - _serving;
+    Unlock();
+
+    // one of them holds the bus
+    return(queue > 0 ? queue - 1 : 0);
+}
+
+/**
+ * @brief : get the bus statistics
+ */
+void SVM40_Bus::GetStats(struct svm40_bus_stats *s) {
+    Lock();
+    *s = _stats;
+    s->elapsed_us = micros() - _since;
+    Unlock();
+}
+
+/**
+ * @brief : clear the bus statistics
+ */
+void SVM40_Bus::ClearStats() {
+    Lock();
+    memset(&_stats, 0, sizeof(_stats));
+    _since = micros();
+    Unlock();
+}
+
+/**
+ * @brief : % of the time the bus was held since ClearStats()
+ */
+float SVM40_Bus::GetUtilisation() {
+    struct svm40_bus_stats s;
+
+    GetStats(&s);
+    if (s.elapsed_us == 0) return(0);
+
+    return((float) s.busy_us * 100 / s.elapsed_us);
+}
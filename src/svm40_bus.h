@@ -0,0 +1,142 @@
+/**
+ * SVM40 Library shared I2C bus arbiter
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * When the SVM40 shares a Wire bus with other devices that are driven
+ * from other tasks, each transaction must have the bus for itself. An
+ * SVM40 command is a write, a wait (100mS or more) and a read. Holding a
+ * lock around the whole command blocks the bus during the wait.
+ *
+ * SVM40_Bus is given to the SVM40 instead of the Wire port. The driver
+ * then holds the bus for the write and for the read, but NOT during the
+ * wait in between. Other drivers on the same bus do the same :
+ *
+ *   SVM40_Bus bus(&Wire);
+ *   svm40.begin(&bus);
+ *
+ *   bus.Acquire();                       // in the other driver
+ *   Wire.beginTransmission(...); ...     // complete write or read
+ *   bus.Release();
+ *
+ * Waiting tasks get the bus in the order they asked for it (ticket lock),
+ * so a busy task can not starve the others. While waiting yield() is
+ * called. With more than one task SetLock() MUST be called with a lock
+ * from the RTOS (or std::mutex on a host) as the ticket counters are
+ * shared. A single task (no RTOS) does not need a lock.
+ *
+ * GetStats() reports the number of transactions, the time the bus was
+ * held and the time tasks had to wait. The times are in uS, so clear the
+ * statistics at least every hour.
+ *********************************************************************
+ */
+#ifndef SVM40_BUS_H
+#define SVM40_BUS_H
+
+#include "svm40.h"
+
+// bus statistics (since ClearStats())
+struct svm40_bus_stats
+{
+    uint32_t   transactions;       // times the bus was acquired
+    uint32_t   busy_us;            // time the bus was held
+    uint32_t   hold_max_us;        // longest time the bus was held
+    uint32_t   wait_us;            // total time waited for the bus
+    uint32_t   wait_max_us;        // longest wait for the bus
+    uint32_t   elapsed_us;         // time since ClearStats()
+    uint16_t   queue_max;          // most tasks waiting at the same time
+};
+
+class SVM40_Bus
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param wire : Wire port that is shared
+     */
+    SVM40_Bus(TwoWire *wire);
+
+    /**
+     * @brief : the shared Wire port
+     */
+    TwoWire *GetWire() {return(_wire);}
+
+    /**
+     * @brief : set a lock to protect the ticket counters
+     * @param cb  : routine to call (NULL = single task)
+     * @param arg : passed to the routine
+     *
+     * The lock is only held for a short time and does not need to be
+     * recursive.
+     */
+    void SetLock(svm40_lock_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : wait for the bus (in order of request) and hold it
+     *
+     * Every Acquire() must be followed by a Release() from the same task.
+     */
+    void Acquire();
+
+    /**
+     * @brief : release the bus for the next task waiting
+     */
+    void Release();
+
+    /**
+     * @brief : number of tasks waiting for the bus
+     */
+    uint16_t Waiting();
+
+    /**
+     * @brief : get / clear the bus statistics
+     * @param s : pointer to structure to store
+     */
+    void GetStats(struct svm40_bus_stats *s);
+    void ClearStats();
+
+    /**
+     * @brief : % of the time the bus was held since ClearStats()
+     */
+    float GetUtilisation();
+
+  private:
+
+    void Lock()   {if (_lock) _lock(_lock_arg, true);}
+    void Unlock() {if (_lock) _lock(_lock_arg, false);}
+
+    TwoWire        *_wire;
+    svm40_lock_cb  _lock;             // protect the variables below
+    void           *_lock_arg;
+
+    volatile uint16_t _next;          // next ticket to hand out
+    volatile uint16_t _serving;       // ticket that holds the bus
+    uint32_t       _held;             // micros() the bus was acquired
+    uint32_t       _since;            // micros() of ClearStats()
+    struct svm40_bus_stats _stats;
+};
+
+#endif /* SVM40_BUS_H */
@@ -0,0 +1,293 @@
+/**
+ * SVM40 Library bus capture and replay
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_capture.h"
+
+/*******************************************************************
+ *  CAPTURE
+ *******************************************************************/
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Capture::SVM40_Capture(void) {
+    _svm = NULL;
+    _out = NULL;
+    _len = 0;
+    _bytes = 0;
+}
+
+/**
+ * @brief : start capture
+ * @param s         : driver to capture
+ * @param out       : where to write the capture
+ * @param transport : SVM40_CAPTURE_UART or SVM40_CAPTURE_I2C
+ */
+void SVM40_Capture::begin(SVM40 *s, Print *out, uint8_t transport) {
+    uint8_t hdr[6] = {'S', 'V', 'M', '4', SVM40_CAPTURE_VERSION, transport};
+
+    _svm = s;
+    _out = out;
+    _len = 0;
+    _last = millis();
+
+    _bytes = _out->write(hdr, sizeof(hdr));
+
+    _svm->SetTrace(Trace, this);
+}
+
+/**
+ * @brief : stop capture
+ */
+void SVM40_Capture::end() {
+
+    if (_svm == NULL) return;
+
+    _svm->SetTrace(NULL);
+    Flush();
+    _svm = NULL;
+}
+
+/**
+ * @brief : called by the driver
+ */
+void SVM40_Capture::Trace(void *arg, uint8_t dir, const uint8_t *data, uint8_t len) {
+    ((SVM40_Capture *) arg)->Add(dir, data, len);
+}
+
+/**
+ * @brief : add bytes to the pending record
+ *
+ * Bytes in the same direction are combined in one record.
+ */
+void SVM40_Capture::Add(uint8_t dir, const uint8_t *data, uint8_t len) {
+
+    dir = dir == SVM40_TRACE_RX ? SVM40_CAPTURE_RX : 0;
+
+    if (_len > 0 && dir != _dir) Flush();
+
+    while (len--) {
+
+        if (_len == 0) {
+            _dir = dir;
+            _time = millis();
+        }
+
+        _buf[_len++] = *data++;
+
+        if (_len == SVM40_CAPTURE_MAXREC) Flush();
+    }
+}
+
+/**
+ * @brief : write pending record
+ */
+void SVM40_Capture::Flush() {
+    uint8_t hdr[3];
+    uint32_t delta;
+
+    if (_len == 0) return;
+
+    delta = _time - _last;
+    if (delta > 0xffff) delta = 0xffff;
+    _last = _time;
+
+    hdr[0] = _dir | (_len - 1);
+    hdr[1] = delta & 0xff;
+    hdr[2] = delta >> 8;
+
+    _bytes += _out->write(hdr, sizeof(hdr));
+    _bytes += _out->write(_buf, _len);
+    _len = 0;
+}
+
+/*******************************************************************
+ *  REPLAY
+ *******************************************************************/
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Replay::SVM40_Replay(void) {
+    _src = NULL;
+    _len = _pos = 0;
+    _mismatch = 0;
+}
+
+/**
+ * @brief : start replay
+ * @param src : capture to replay
+ *
+ * @return :
+ *  true if a valid capture header was read
+ */
+bool SVM40_Replay::begin(Stream *src) {
+    uint8_t hdr[6];
+
+    _src = src;
+    _len = _pos = 0;
+    _mismatch = 0;
+
+    if (ReadSrc(hdr, sizeof(hdr)) != sizeof(hdr)) return(false);
+
+    if (hdr[0] != 'S' || hdr[1] != 'V' || hdr[2] != 'M' || hdr[3] != '4') return(false);
+    if (hdr[4] != SVM40_CAPTURE_VERSION) return(false);
+
+    _transport = hdr[5];
+    return(true);
+}
+
+/**
+ * @brief : read bytes from the capture
+ *
+ * @return :
+ *  number of bytes read (less at end of capture)
+ */
+uint8_t SVM40_Replay::ReadSrc(uint8_t *buf, uint8_t len) {
+    int c;
+    uint8_t i;
+
+    for (i = 0; i < len; i++) {
+        c = _src->read();
+        if (c < 0) break;
+        buf[i] = (uint8_t) c;
+    }
+
+    return(i);
+}
+
+/**
+ * @brief : read the next record from the capture
+ *
+ * @return :
+ *  true if available, false if end of capture
+ */
+bool SVM40_Replay::Next() {
+    uint8_t hdr[3];
+
+    _len = _pos = 0;
+
+    if (_src == NULL) return(false);
+    if (ReadSrc(hdr, sizeof(hdr)) != sizeof(hdr)) return(false);
+
+    _dir = hdr[0] & SVM40_CAPTURE_RX;
+    _len = (hdr[0] & 0x7f) + 1;
+
+    if (ReadSrc(_buf, _len) != _len) {
+        _len = 0;
+        return(false);
+    }
+
+    return(true);
+}
+
+/**
+ * @brief : make sure there is a record with bytes left
+ *
+ * @return :
+ *  true if available, false if end of capture
+ */
+bool SVM40_Replay::Current() {
+    if (_pos < _len) return(true);
+    return(Next());
+}
+
+/**
+ * @brief : end of capture reached
+ */
+bool SVM40_Replay::IsDone() {
+    return(! Current());
+}
+
+/**
+ * @brief : get the next request to the sensor
+ * @param buf : to store the bytes
+ *
+ * @return :
+ *  number of bytes or zero if end of capture
+ */
+uint8_t SVM40_Replay::PeekRequest(uint8_t *buf) {
+
+    while (Current()) {
+
+        // skip response bytes the driver did not read
+        if (_dir == SVM40_CAPTURE_RX) {
+            _pos = _len;
+            continue;
+        }
+
+        memcpy(buf, &_buf[_pos], _len - _pos);
+        return(_len - _pos);
+    }
+
+    return(0);
+}
+
+/**
+ * @brief : byte written by the driver
+ *
+ * compared with the capture to detect a different request
+ */
+size_t SVM40_Replay::write(uint8_t b) {
+
+    // response not read completely : skip
+    if (_pos < _len && _dir == SVM40_CAPTURE_RX) _pos = _len;
+
+    if (! Current() || _dir == SVM40_CAPTURE_RX) {
+        _mismatch++;
+        return(1);
+    }
+
+    if (_buf[_pos++] != b) _mismatch++;
+
+    return(1);
+}
+
+/**
+ * @brief : number of response bytes available
+ *
+ * Only after all request bytes have been written by the driver.
+ */
+int SVM40_Replay::available() {
+
+    if (! Current()) return(0);
+    if (_dir != SVM40_CAPTURE_RX) return(0);
+
+    return(_len - _pos);
+}
+
+int SVM40_Replay::read() {
+    if (available() == 0) return(-1);
+    return(_buf[_pos++]);
+}
+
+int SVM40_Replay::peek() {
+    if (available() == 0) return(-1);
+    return(_buf[_pos]);
+}
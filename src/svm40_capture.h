@@ -0,0 +1,173 @@
+/**
+ * SVM40 Library bus capture and replay
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * SVM40_Capture records every byte sent to and received from the sensor
+ * with a timestamp to any Print (e.g. an SD-card File or a Serial port).
+ *
+ *   SVM40_Capture cap;
+ *   cap.begin(&svm40, &logfile, SVM40_CAPTURE_UART);
+ *   ...
+ *   cap.Flush();
+ *
+ * SVM40_Replay is a Stream that plays a capture back to the driver. The
+ * bytes from the sensor are presented after the driver has sent the
+ * request bytes, without delay. Use it instead of the serial port :
+ *
+ *   replay.begin(&logfile);
+ *   svm40.begin(&replay);
+ *
+ * On Linux see extras/replay for a tool that replays a capture with the
+ * driver at full speed (UART and I2C).
+ *
+ * Capture format (binary) :
+ *   header : 'S' 'V' 'M' '4' version(1) transport(1)
+ *   record : dir/length(1) delta mS(2, LSB first) data(length)
+ *            dir/length : bit 7 set = from sensor, bit 6-0 = length - 1
+ *            delta      : mS since previous record (max 65535)
+ *********************************************************************
+ */
+#ifndef SVM40_CAPTURE_H
+#define SVM40_CAPTURE_H
+
+#include "svm40.h"
+
+#define SVM40_CAPTURE_VERSION   1
+#define SVM40_CAPTURE_UART      0
+#define SVM40_CAPTURE_I2C       1
+#define SVM40_CAPTURE_RX        0x80        // dir bit in record
+#define SVM40_CAPTURE_MAXREC    128         // max data bytes in record
+
+class SVM40_Capture
+{
+  public:
+
+    SVM40_Capture(void);
+
+    /**
+     * @brief : start capture
+     * @param s         : driver to capture
+     * @param out       : where to write the capture
+     * @param transport : SVM40_CAPTURE_UART or SVM40_CAPTURE_I2C
+     */
+    void begin(SVM40 *s, Print *out, uint8_t transport);
+
+    /**
+     * @brief : stop capture (pending bytes are written)
+     */
+    void end();
+
+    /**
+     * @brief : write pending bytes
+     */
+    void Flush();
+
+    /**
+     * @brief : bytes written to the output
+     */
+    uint32_t GetBytes() {return(_bytes);}
+
+  private:
+
+    static void Trace(void *arg, uint8_t dir, const uint8_t *data, uint8_t len);
+    void        Add(uint8_t dir, const uint8_t *data, uint8_t len);
+
+    SVM40    *_svm;
+    Print    *_out;
+    uint32_t _last;                 // time of previous record
+    uint32_t _time;                 // time of pending record
+    uint32_t _bytes;
+    uint8_t  _dir;                  // direction of pending record
+    uint8_t  _len;                  // pending bytes
+    uint8_t  _buf[SVM40_CAPTURE_MAXREC];
+};
+
+class SVM40_Replay : public Stream
+{
+  public:
+
+    SVM40_Replay(void);
+
+    /**
+     * @brief : start replay
+     * @param src : capture to replay
+     *
+     * @return :
+     *  true if a valid capture header was read
+     */
+    bool begin(Stream *src);
+
+    /**
+     * @brief : transport in the capture (SVM40_CAPTURE_UART / I2C)
+     */
+    uint8_t GetTransport() {return(_transport);}
+
+    /**
+     * @brief : get the next request to the sensor in the capture
+     * @param buf : to store the bytes (SVM40_CAPTURE_MAXREC)
+     *
+     * Any response bytes not read by the driver are skipped.
+     *
+     * @return :
+     *  number of bytes or zero if end of capture
+     */
+    uint8_t PeekRequest(uint8_t *buf);
+
+    /**
+     * @brief : end of capture reached
+     */
+    bool IsDone();
+
+    /**
+     * @brief : bytes written by the driver that differ from the capture
+     */
+    uint32_t GetMismatch() {return(_mismatch);}
+
+    // Stream
+    size_t write(uint8_t b);
+    int    available();
+    int    read();
+    int    peek();
+    void   flush() {}
+
+    using Print::write;
+
+  private:
+
+    uint8_t ReadSrc(uint8_t *buf, uint8_t len);
+    bool    Next();
+    bool    Current();
+
+    Stream   *_src;
+    uint32_t _mismatch;
+    uint8_t  _transport;
+    uint8_t  _dir;                  // direction of current record
+    uint8_t  _len;                  // bytes in current record
+    uint8_t  _pos;                  // bytes handled in current record
+    uint8_t  _buf[SVM40_CAPTURE_MAXREC];
+};
+
+#endif /* SVM40_CAPTURE_H */
@@ -0,0 +1,244 @@
+/**
+ * SVM40 Library VOC algorithm state checkpoint
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ * - restore the state after a reboot of the sensor
+ *
+ * A checkpoint record (SVM40_CP_RECORD bytes) :
+ *   0      'C'
+ *   1      sequence number (highest is the latest, wraps, compared
+ *          as a signed difference so at most 127 slots)
+ *   2 - 5  time saved (clock(), LSB first)
+ *   6 - 9  operation time in seconds (LSB first)
+ *   10 -17 VOC algorithm state
+ *   18     reserved (0)
+ *   19     CRC-8 of byte 0 - 18
+ *********************************************************************
+ */
+
+#include "svm40_checkpoint.h"
+
+#define CP_MAGIC  'C'
+
+/**
+ * @brief : store / get a uint32_t LSB first
+ */
+static void put32(uint8_t *p, uint32_t v) {
+    for (uint8_t i = 0; i < 4; i++) p[i] = v >> (i * 8);
+}
+
+static uint32_t get32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < 4; i++) v |= (uint32_t) p[i] << (i * 8);
+    return(v);
+}
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Checkpoint::SVM40_Checkpoint(void) {
+    _svm = NULL;
+    _store = NULL;
+    _clock = NULL;
+    _slots = 0;
+    _saved = 0;
+}
+
+/**
+ * @brief : start the checkpoint manager, find the latest checkpoint
+ */
+void SVM40_Checkpoint::begin(SVM40 *s, SVM40_Storage *store, svm40_clock_cb clock, uint16_t interval) {
+    uint8_t rec[SVM40_CP_RECORD];
+    bool found = false;
+
+    _svm = s;
+    _store = store;
+    _clock = clock;
+    _interval = interval;
+    if (_store->Size() / SVM40_CP_RECORD > SVM40_CP_MAX_SLOTS) _slots = SVM40_CP_MAX_SLOTS;
+    else _slots = _store->Size() / SVM40_CP_RECORD;
+    _saved = _run = 0;
+
+    for (uint8_t i = 0; i < _slots; i++) {
+
+        if (! ReadSlot(i, rec)) continue;
+
+        // newer (the sequence number wraps)
+        if (! found || (int8_t) (rec[1] - _seq) > 0) {
+            found = true;
+            _slot = i;
+            _seq = rec[1];
+            _saved = get32(&rec[2]);
+            _run = get32(&rec[6]);
+            memcpy(_state, &rec[10], sizeof(_state));
+        }
+    }
+
+    // the next save goes to slot 0
+    if (! found) {
+        _slot = _slots - 1;
+        _seq = 0;
+    }
+
+    Clear();
+
+    _svm->SetRebootHandler(OnReboot, this);
+}
+
+/**
+ * @brief : called by the driver after a reboot of the sensor
+ */
+void SVM40_Checkpoint::OnReboot(void *arg) {
+    SVM40_Checkpoint *cp = (SVM40_Checkpoint *) arg;
+
+    // else the learning starts again
+    if (cp->Restore() != SVM40_CP_RESTORED) cp->Clear();
+}
+
+/**
+ * @brief : write the latest state to the sensor if saved recently
+ */
+uint8_t SVM40_Checkpoint::Restore() {
+    uint32_t now;
+
+    if (_saved == 0) return(SVM40_CP_NONE);
+
+    now = _clock();
+
+    if (now < _saved || now - _saved > SVM40_CP_MAX_GAP) return(SVM40_CP_TOO_OLD);
+
+    if (_svm->SetVocState(_state) != ERR_OK) return(SVM40_CP_ERROR);
+
+    // the operation time continues
+    _start = now - _run;
+    _due = now;
+
+    return(SVM40_CP_RESTORED);
+}
+
+/**
+ * @brief : save the state when due
+ */
+bool SVM40_Checkpoint::loop() {
+    uint32_t now;
+
+    if (_slots == 0) return(false);
+
+    now = _clock();
+    if ((int32_t) (now - _due) < 0) return(false);
+
+    // also after a failure
+    _due = now + _interval;
+
+    return(Save());
+}
+
+/**
+ * @brief : save the state in the next slot
+ */
+bool SVM40_Checkpoint::Save() {
+    uint8_t rec[SVM40_CP_RECORD], slot;
+    uint32_t now, run;
+
+    if (_slots == 0) return(false);
+
+    now = _clock();
+    run = now - _start;
+
+    if (run < SVM40_CP_MIN_RUN) return(false);
+
+    if (_svm->GetVocState(&rec[10]) != ERR_OK) return(false);
+
+    slot = _slot + 1;
+    if (slot >= _slots) slot = 0;
+
+    rec[0] = CP_MAGIC;
+    rec[1] = _seq + 1;
+    put32(&rec[2], now);
+    put32(&rec[6], run);
+    rec[18] = 0;
+    rec[19] = CRC(rec);
+
+    if (! _store->Write(slot * SVM40_CP_RECORD, rec, SVM40_CP_RECORD)) return(false);
+
+    _slot = slot;
+    _seq++;
+    _saved = now;
+    _run = run;
+    _due = now + _interval;
+    memcpy(_state, &rec[10], sizeof(_state));
+
+    return(true);
+}
+
+/**
+ * @brief : the operation time starts again
+ */
+void SVM40_Checkpoint::Clear() {
+    _start = _clock();
+    _due = _start + SVM40_CP_MIN_RUN;
+}
+
+/**
+ * @brief : seconds of operation
+ */
+uint32_t SVM40_Checkpoint::GetRunTime() {
+    return(_clock() - _start);
+}
+
+/**
+ * @brief : latest state saved or restored
+ */
+uint32_t SVM40_Checkpoint::GetLatest(uint8_t *p) {
+    if (_saved != 0) memcpy(p, _state, sizeof(_state));
+    return(_saved);
+}
+
+/**
+ * @brief : read a slot and check it
+ */
+bool SVM40_Checkpoint::ReadSlot(uint8_t slot, uint8_t *rec) {
+
+    if (! _store->Read(slot * SVM40_CP_RECORD, rec, SVM40_CP_RECORD)) return(false);
+
+    return(rec[0] == CP_MAGIC && rec[19] == CRC(rec));
+}
+
+/**
+ * @brief : CRC-8 (as used on I2C) of a record
+ */
+uint8_t SVM40_Checkpoint::CRC(const uint8_t *rec) {
+    uint8_t crc = 0xFF;
+
+    for (uint8_t i = 0; i < SVM40_CP_RECORD - 1; i++) {
+        crc ^= rec[i];
+        for (uint8_t bit = 8; bit > 0; --bit) {
+            if (crc & 0x80) crc = (crc << 1) ^ 0x31u;
+            else crc = (crc << 1);
+        }
+    }
+
+    return(crc);
+}
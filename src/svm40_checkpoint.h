@@ -0,0 +1,181 @@
+/**
+ * SVM40 Library VOC algorithm state checkpoint
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ * - restore the state after a reboot of the sensor
+ *
+ * After at least 3 hours of measurement the VOC algorithm state can be
+ * read (GetVocState()) and, after an interruption of less than 10 minutes,
+ * written back (SetVocState()) to skip the learning phase.
+ *
+ * SVM40_Checkpoint does this : loop() saves the state every interval
+ * (default 5 minutes) once the sensor has been measuring for 3 hours.
+ * Restore() at startup writes the latest saved state back if it was saved
+ * less than 10 minutes ago.
+ *
+ * The state is saved with the time and a CRC in a storage backend
+ * (SVM40_Storage). Each save goes to the next slot of 20 bytes, so the
+ * wear is spread over the storage (e.g. 200 bytes = 10 slots). At most
+ * SVM40_CP_MAX_SLOTS slots are used (the 8-bit sequence number must tell
+ * the latest apart), the rest of a larger storage is left alone. Backends :
+ *   svm40_eeprom_storage.h     : EEPROM (AVR, ESP32, ESP8266 ...)
+ *   extras/host/svm40_file_storage.h : file on Linux
+ * Or derive from SVM40_Storage for e.g. flash or FRAM.
+ *
+ * The time MUST survive a reset of the MCU, so provide a routine that
+ * returns the time in seconds from an RTC, NTP or GPS. With a clock that
+ * restarts (e.g. millis() / 1000) the state is never restored.
+ *********************************************************************
+ */
+#ifndef SVM40_CHECKPOINT_H
+#define SVM40_CHECKPOINT_H
+
+#include "svm40.h"
+
+#define SVM40_CP_MIN_RUN    10800           // seconds before the state can be saved
+#define SVM40_CP_MAX_GAP    600             // seconds the state can be restored after
+#define SVM40_CP_INTERVAL   300             // default seconds between saves
+#define SVM40_CP_RECORD     20              // bytes per slot
+#define SVM40_CP_MAX_SLOTS  127             // slots used at most (2540 bytes)
+
+// Restore() result
+#define SVM40_CP_RESTORED   0               // state written to the sensor
+#define SVM40_CP_NONE       1               // no valid checkpoint
+#define SVM40_CP_TOO_OLD    2               // saved too long ago (or clock went back)
+#define SVM40_CP_ERROR      3               // sensor did not accept
+
+// time in seconds, MUST continue over an MCU reset (RTC, NTP..)
+typedef uint32_t (*svm40_clock_cb)(void);
+
+/**
+ * storage backend for the checkpoints
+ */
+class SVM40_Storage
+{
+  public:
+    /**
+     * @brief : number of bytes available
+     */
+    virtual uint16_t Size() = 0;
+
+    /**
+     * @brief : read / write bytes
+     * @param addr : offset in the storage
+     * @param buf  : data
+     * @param len  : number of bytes
+     *
+     * @return :
+     *  true if OK else false
+     */
+    virtual bool Read(uint16_t addr, uint8_t *buf, uint8_t len) = 0;
+    virtual bool Write(uint16_t addr, const uint8_t *buf, uint8_t len) = 0;
+};
+
+class SVM40_Checkpoint
+{
+  public:
+
+    SVM40_Checkpoint(void);
+
+    /**
+     * @brief : start the checkpoint manager
+     * @param s        : driver
+     * @param store    : storage backend
+     * @param clock    : time in seconds
+     * @param interval : seconds between saves (less than SVM40_CP_MAX_GAP)
+     *
+     * The operation time is counted from now. The checkpoint is set as
+     * reboot handler of the driver (SetRebootHandler()) : after a reboot of
+     * the sensor the latest state is restored if saved recently.
+     */
+    void begin(SVM40 *s, SVM40_Storage *store, svm40_clock_cb clock, uint16_t interval = SVM40_CP_INTERVAL);
+
+    /**
+     * @brief : write the latest saved state to the sensor if saved less
+     * than SVM40_CP_MAX_GAP seconds ago. Call after begin() at startup.
+     *
+     * If restored, the operation time continues from the saved one.
+     *
+     * @return :
+     *  SVM40_CP_RESTORED, SVM40_CP_NONE, SVM40_CP_TOO_OLD or SVM40_CP_ERROR
+     */
+    uint8_t Restore();
+
+    /**
+     * @brief : call regularly, saves the state when due
+     *
+     * @return :
+     *  true if a checkpoint was saved
+     */
+    bool loop();
+
+    /**
+     * @brief : save the state now (e.g. before a planned power down)
+     *
+     * @return :
+     *  true if saved, false if operating less than 3 hours or error
+     */
+    bool Save();
+
+    /**
+     * @brief : the operation time was lost (e.g. the sensor was reset)
+     */
+    void Clear();
+
+    /**
+     * @brief : seconds of operation (including a restored state)
+     */
+    uint32_t GetRunTime();
+
+    /**
+     * @brief : latest state saved or restored
+     * @param p : to store the 8 bytes
+     *
+     * @return :
+     *  time it was saved, 0 if none
+     */
+    uint32_t GetLatest(uint8_t *p);
+
+  private:
+
+    static void OnReboot(void *arg);
+    bool    ReadSlot(uint8_t slot, uint8_t *rec);
+    uint8_t CRC(const uint8_t *rec);
+
+    SVM40          *_svm;
+    SVM40_Storage  *_store;
+    svm40_clock_cb _clock;
+    uint16_t       _interval;
+    uint8_t        _slots;            // number of slots in the storage
+    uint8_t        _slot;             // slot of the latest checkpoint
+    uint8_t        _seq;              // sequence of the latest checkpoint
+    uint32_t       _start;            // clock() the operation started
+    uint32_t       _saved;            // clock() of the latest checkpoint
+    uint32_t       _run;              // operation time of the latest checkpoint
+    uint32_t       _due;              // clock() next save is due
+    uint8_t        _state[8];         // latest state
+};
+
+#endif /* SVM40_CHECKPOINT_H */
@@ -0,0 +1,324 @@
+/**
+ * SVM40 Library port auto-detection
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * See svm40_detect.h
+ *********************************************************************
+ */
+
+#include "svm40_detect.h"
+
+/**
+ * @brief constructor
+ */
+SVM40_Detect::SVM40_Detect(void) {
+    _count = 0;
+    _found = -1;
+    _time = 0;
+}
+
+/**
+ * @brief : add a candidate serial port
+ */
+bool SVM40_Detect::Add(Stream *port) {
+#if defined INCLUDE_UART
+    if (_count == SVM40_DETECT_PORTS) return(false);
+
+    _port[_count].serial = port;
+    _port[_count].wire = NULL;
+    _count++;
+    return(true);
+#else
+    (void) port;
+    return(false);
+#endif // INCLUDE_UART
+}
+
+/**
+ * @brief : add a candidate Wire port
+ */
+bool SVM40_Detect::Add(TwoWire *port) {
+#if defined INCLUDE_I2C
+    if (_count == SVM40_DETECT_PORTS) return(false);
+
+    _port[_count].serial = NULL;
+    _port[_count].wire = port;
+    _count++;
+    return(true);
+#else
+    (void) port;
+    return(false);
+#endif // INCLUDE_I2C
+}
+
+/**
+ * @brief : find the sensor
+ * @param svm     : driver to begin on the port found (NULL = none)
+ * @param timeout : maximum mS to wait for an answer
+ *
+ * @return :
+ *  index of the port found, -1 if not found
+ */
+int8_t SVM40_Detect::Run(SVM40 *svm, uint16_t timeout) {
+    uint32_t st, poll;
+    uint8_t i, busy;
+
+    st = millis();
+    _found = -1;
+
+    // send the request on all ports
+    for (i = 0; i < _count; i++) Send(&_port[i]);
+
+    poll = millis();
+
+    while (_found < 0) {
+
+        busy = 0;
+
+        for (i = 0; i < _count; i++) {
+
+            if (_port[i].done) continue;
+            busy++;
+
+            // Wire ports are read every SVM40_DETECT_POLL mS, the
+            // serial ports as bytes come in
+            if (_port[i].wire && millis() - poll < SVM40_DETECT_POLL) continue;
+
+            if (Poll(&_port[i])) {
+                _found = i;
+                break;
+            }
+        }
+
+        if (_found >= 0 || busy == 0) break;
+        if (millis() - st > timeout) break;
+
+        if (millis() - poll >= SVM40_DETECT_POLL) poll = millis();
+        delay(1);
+    }
+
+    _time = millis() - st;
+
+    if (_found < 0 || svm == NULL) return(_found);
+
+#if defined INCLUDE_I2C
+    if (_port[_found].wire) svm->begin(_port[_found].wire);
+#endif
+#if defined INCLUDE_UART
+    if (_port[_found].serial) svm->begin(_port[_found].serial);
+#endif
+
+    return(_found);
+}
+
+/**
+ * @brief : get the version of the sensor found in the last Run()
+ *
+ * @return :
+ *  true if found, else false
+ */
+bool SVM40_Detect::GetVersion(SVM40_version *v) {
+    uint8_t *b;
+
+    memset(v, 0x0, sizeof(struct SVM40_version));
+    if (_found < 0) return(false);
+
+    // UART : addr cmd state length data, Wire : data
+    b = _port[_found].buf;
+    if (_port[_found].serial) b += 4;
+
+    v->major = b[0];
+    v->minor = b[1];
+    v->debug = b[2];
+    v->HW_major = b[3];
+    v->HW_minor = b[4];
+    v->SHDLC_major = b[5];
+    v->SHDLC_minor = b[6];
+    v->DRV_major = DRIVER_MAJOR;
+    v->DRV_minor = DRIVER_MINOR;
+    return(true);
+}
+
+/**
+ * @brief : send the version request (does not wait)
+ */
+void SVM40_Detect::Send(struct port *p) {
+
+    p->done = false;
+    p->len = 0;
+    p->stuff = false;
+
+#if defined INCLUDE_UART
+    if (p->serial) {
+        // addr 0, cmd, length 0, CRC (no stuffing needed)
+        uint8_t req[6] = {SHDLC_IND, 0x0, SVM40_SHDLC_GET_VERSION, 0x0, 0x0, SHDLC_IND};
+        req[4] = ~(req[1] + req[2] + req[3]);
+
+        // remove what was received before
+        while (p->serial->available()) p->serial->read();
+
+        p->serial->write(req, sizeof(req));
+        return;
+    }
+#endif // INCLUDE_UART
+
+#if defined INCLUDE_I2C
+    if (p->wire) {
+        p->wire->beginTransmission(SVM40_I2C_ADDRESS);
+        p->wire->write((uint8_t) (SVM40_I2C_GET_VERSION >> 8));
+        p->wire->write((uint8_t) (SVM40_I2C_GET_VERSION & 0xff));
+
+        // no device on this bus
+        if (p->wire->endTransmission() != 0) p->done = true;
+    }
+#endif // INCLUDE_I2C
+}
+
+/**
+ * @brief : check for a (complete) answer
+ *
+ * @return :
+ *  true if a valid answer was received
+ */
+bool SVM40_Detect::Poll(struct port *p) {
+
+#if defined INCLUDE_UART
+    if (p->serial) {
+        while (p->serial->available()) {
+            if (SerialByte(p, (uint8_t) p->serial->read())) return(true);
+        }
+        return(false);
+    }
+#endif // INCLUDE_UART
+
+#if defined INCLUDE_I2C
+    if (p->wire) return(WireAnswer(p));
+#endif // INCLUDE_I2C
+
+    return(false);
+}
+
+#if defined INCLUDE_UART
+/**
+ * @brief : add a byte of a serial answer
+ *
+ * frame : 0x7E addr cmd state length data[7] crc 0x7E
+ * Only addr .. crc are kept in buf. Anything else is skipped.
+ *
+ * @return :
+ *  true if a valid answer was received
+ */
+bool SVM40_Detect::SerialByte(struct port *p, uint8_t c) {
+    uint8_t i, crc;
+
+    if (c == SHDLC_IND) {
+
+        // start of frame
+        if (p->len == 0) return(false);
+
+        // end of frame
+        if (p->len == 12 && p->buf[0] == 0x0 && p->buf[1] == SVM40_SHDLC_GET_VERSION
+            && p->buf[2] == SVM40_ERR_OK && p->buf[3] == 7) {
+
+            for (i = 0, crc = 0; i < 11; i++) crc += p->buf[i];
+            if ((uint8_t) ~crc == p->buf[11]) return(true);
+        }
+
+        // not an answer to the request, wait for the next frame
+        p->len = 0;
+        p->stuff = false;
+        return(false);
+    }
+
+    if (c == 0x7D) {
+        p->stuff = true;
+        return(false);
+    }
+
+    if (p->stuff) {
+        c ^= 0x20;
+        p->stuff = false;
+    }
+
+    if (p->len < sizeof(p->buf)) p->buf[p->len++] = c;
+
+    return(false);
+}
+#endif // INCLUDE_UART
+
+#if defined INCLUDE_I2C
+/**
+ * @brief : read the answer on a Wire port
+ *
+ * The sensor does not acknowledge a read before the answer is ready or
+ * returns data with a wrong CRC, so the read is just tried again later.
+ *
+ * @return :
+ *  true if a valid answer was received
+ */
+bool SVM40_Detect::WireAnswer(struct port *p) {
+    uint8_t data[3], i, j;
+
+    // 8 data bytes, a CRC after each 2
+    if (p->wire->requestFrom((uint8_t) SVM40_I2C_ADDRESS, (uint8_t) 12) != 12) {
+        while (p->wire->available()) p->wire->read();
+        return(false);
+    }
+
+    for (i = 0, j = 0; i < 12; i++) {
+
+        data[i % 3] = p->wire->read();
+
+        if (i % 3 == 2) {
+            if (data[2] != CRC8(data)) {
+                while (p->wire->available()) p->wire->read();
+                return(false);
+            }
+
+            p->buf[j++] = data[0];
+            p->buf[j++] = data[1];
+        }
+    }
+
+    return(true);
+}
+
+/**
+ * @brief : CRC of 2 bytes on I2C (see SVM40::I2C_calc_CRC())
+ */
+uint8_t SVM40_Detect::CRC8(uint8_t *data) {
+    uint8_t crc = 0xFF;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 8; bit > 0; --bit) {
+            if (crc & 0x80) crc = (crc << 1) ^ 0x31u;
+            else crc = (crc << 1);
+        }
+    }
+    return(crc);
+}
+#endif // INCLUDE_I2C
@@ -0,0 +1,116 @@
+/**
+ * SVM40 Library port auto-detection
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Find the SVM40 on one of several serial ports and / or Wire buses.
+ * Calling probe() on each port in turn takes 100mS or more per port and
+ * up to TIME_OUT (5 seconds) on a serial port without a sensor.
+ *
+ * SVM40_Detect sends the version request on all ports at the same time
+ * and then reads the answers as they come in. The first answer with a
+ * correct frame and CRC wins and the SVM40 is begun on that port :
+ *
+ *   SVM40_Detect det;
+ *   det.Add(&Serial1);
+ *   det.Add(&Serial2);
+ *   det.Add(&Wire);
+ *
+ *   if (det.Run(&svm40) < 0) ... not found
+ *
+ * The serial ports must have been begun at 115200, the Wire ports begun.
+ * A Wire port without the sensor is found out at once (address NACK).
+ * A Wire port is read again every SVM40_DETECT_POLL mS until the sensor
+ * has an answer with a correct CRC.
+ *********************************************************************
+ */
+#ifndef SVM40_DETECT_H
+#define SVM40_DETECT_H
+
+#include "svm40.h"
+
+#define SVM40_DETECT_PORTS    6     // maximum candidate ports
+#define SVM40_DETECT_TIMEOUT  250   // mS, default wait for an answer
+#define SVM40_DETECT_POLL     5     // mS between reads on a Wire port
+
+class SVM40_Detect
+{
+  public:
+
+    SVM40_Detect(void);
+
+    /**
+     * @brief : add a candidate port
+     *
+     * @return :
+     *  true if added, false if SVM40_DETECT_PORTS are added already
+     *  or the transport is not included (SVM40_NO_UART / SVM40_NO_I2C)
+     */
+    bool Add(Stream *port);
+    bool Add(TwoWire *port);
+
+    /**
+     * @brief : find the sensor
+     * @param svm     : driver to begin on the port found (NULL = none)
+     * @param timeout : maximum mS to wait for an answer
+     *
+     * @return :
+     *  index of the port found (order of Add()), -1 if not found
+     */
+    int8_t Run(SVM40 *svm, uint16_t timeout = SVM40_DETECT_TIMEOUT);
+
+    /**
+     * @brief : information of the last Run()
+     *
+     * GetVersion() returns false if no sensor was found.
+     */
+    bool     GetVersion(SVM40_version *v);
+    uint32_t GetTime() {return(_time);}    // mS Run() took
+
+  private:
+
+    struct port
+    {
+        Stream   *serial;                   // either serial
+        TwoWire  *wire;                     // or Wire
+        bool     done;                      // no (valid) answer possible
+        uint8_t  len;                       // bytes in buf
+        bool     stuff;                     // next byte is stuffed
+        uint8_t  buf[16];                   // answer (UART : unstuffed)
+    };
+
+    void     Send(struct port *p);
+    bool     Poll(struct port *p);
+    bool     SerialByte(struct port *p, uint8_t c);
+    bool     WireAnswer(struct port *p);
+    uint8_t  CRC8(uint8_t *data);
+
+    struct port _port[SVM40_DETECT_PORTS];
+    uint8_t  _count;                        // ports added
+    int8_t   _found;                        // port found in last Run()
+    uint32_t _time;                         // mS last Run() took
+};
+
+#endif /* SVM40_DETECT_H */
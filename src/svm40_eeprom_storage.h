@@ -0,0 +1,81 @@
+/**
+ * SVM40 Library EEPROM storage for checkpoints
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Stores the checkpoints (svm40_checkpoint.h) in an area of the EEPROM :
+ *
+ *   SVM40_EepromStorage store(0, 200);     // address 0, 200 bytes = 10 slots
+ *
+ * A byte is only written if it changed. On ESP32 / ESP8266 the EEPROM is
+ * emulated in flash : call EEPROM.begin(size) in setup(), the data is
+ * committed after each write.
+ *
+ * Only include this file in a sketch on a board with EEPROM.h.
+ *********************************************************************
+ */
+#ifndef SVM40_EEPROM_STORAGE_H
+#define SVM40_EEPROM_STORAGE_H
+
+#include <EEPROM.h>
+#include "svm40_checkpoint.h"
+
+class SVM40_EepromStorage : public SVM40_Storage
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param start : first EEPROM address to use
+     * @param size  : number of bytes to use
+     */
+    SVM40_EepromStorage(uint16_t start, uint16_t size) : _start(start), _size(size) {}
+
+    uint16_t Size() {return(_size);}
+
+    bool Read(uint16_t addr, uint8_t *buf, uint8_t len) {
+        if (addr + len > _size) return(false);
+        for (uint8_t i = 0; i < len; i++) buf[i] = EEPROM.read(_start + addr + i);
+        return(true);
+    }
+
+    bool Write(uint16_t addr, const uint8_t *buf, uint8_t len) {
+        if (addr + len > _size) return(false);
+        for (uint8_t i = 0; i < len; i++) {
+            if (EEPROM.read(_start + addr + i) != buf[i]) EEPROM.write(_start + addr + i, buf[i]);
+        }
+#if defined ESP32 || defined ESP8266
+        return(EEPROM.commit());
+#else
+        return(true);
+#endif
+    }
+
+  private:
+    uint16_t _start;
+    uint16_t _size;
+};
+
+#endif /* SVM40_EEPROM_STORAGE_H */
@@ -0,0 +1,169 @@
+/**
+ * SVM40 Library threshold / event engine
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_event.h"
+
+/* rule state */
+#define RULE_FREE       0x0         // not in use
+#define RULE_IDLE       0x1         // condition not true
+#define RULE_PENDING    0x2         // condition true, waiting for duration
+#define RULE_ACTIVE     0x3         // active
+#define RULE_HAVE_PREV  0x80        // previous value available (for rate)
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Events::SVM40_Events(void) {
+    for (uint8_t i = 0; i < SVM40_MAX_RULES; i++) _rules[i].state = RULE_FREE;
+}
+
+/**
+ * @brief : add a rule
+ *
+ * @return :
+ *  rule id or -1 if no space
+ */
+int8_t SVM40_Events::AddRule(svm40_channel ch, svm40_rule_type type, float threshold,
+                              float hysteresis, uint32_t duration, svm40_event_cb cb) {
+    uint8_t i;
+
+    for (i = 0; i < SVM40_MAX_RULES; i++) {
+
+        if (_rules[i].state != RULE_FREE) continue;
+
+        _rules[i].ch = ch;
+        _rules[i].type = type;
+        _rules[i].threshold = threshold;
+        _rules[i].hysteresis = hysteresis;
+        _rules[i].duration = duration;
+        _rules[i].cb = cb;
+        _rules[i].state = RULE_IDLE;
+        return(i);
+    }
+
+    return(-1);
+}
+
+/**
+ * @brief : remove a rule
+ * @param id : rule id as returned by AddRule()
+ */
+void SVM40_Events::RemoveRule(uint8_t id) {
+    if (id < SVM40_MAX_RULES) _rules[id].state = RULE_FREE;
+}
+
+/**
+ * @brief : check whether a rule is active
+ * @param id : rule id as returned by AddRule()
+ */
+bool SVM40_Events::IsActive(uint8_t id) {
+    if (id >= SVM40_MAX_RULES) return(false);
+    return((_rules[id].state & 0x7f) == RULE_ACTIVE);
+}
+
+/**
+ * @brief : check all rules on a new sample
+ * @param v   : sample as obtained from GetValues()
+ * @param now : timestamp in mS
+ */
+void SVM40_Events::Process(struct svm40_values *v, uint32_t now) {
+    uint8_t i, state;
+    float val, chk, rep;
+    bool cond, clear;
+    svm40_rule *r;
+
+    for (i = 0; i < SVM40_MAX_RULES; i++) {
+
+        r = &_rules[i];
+        if (r->state == RULE_FREE) continue;
+
+        val = svm40_channel_value(v, r->ch);
+        state = r->state & 0x7f;
+
+        // rate rules need a previous value
+        if (r->type == SVM40_RULE_RISE || r->type == SVM40_RULE_FALL) {
+
+            if (!(r->state & RULE_HAVE_PREV)) {
+                r->prev = val;
+                r->prev_time = now;
+                r->state |= RULE_HAVE_PREV;
+                continue;
+            }
+
+            // change per minute over the window. Sample to sample a step
+            // of 1 point at 1 Hz would be 60 per minute
+            if (now - r->prev_time < SVM40_EVENT_WINDOW) continue;
+
+            chk = (val - r->prev) * 60000 / (float) (now - r->prev_time);
+            r->prev = val;
+            r->prev_time = now;
+            if (r->type == SVM40_RULE_FALL) chk = -chk;
+        }
+        else if (r->type == SVM40_RULE_BELOW)
+            chk = -val;
+        else
+            chk = val;
+
+        // passed to the callback : the value or the rate
+        rep = r->type >= SVM40_RULE_RISE ? chk : val;
+
+        // all conditions are now 'above' (BELOW and FALL are negated)
+        if (r->type == SVM40_RULE_BELOW) {
+            cond = chk > -r->threshold;
+            clear = chk <= -(r->threshold + r->hysteresis);
+        }
+        else {
+            cond = chk > r->threshold;
+            clear = chk <= r->threshold - r->hysteresis;
+        }
+
+        if (state == RULE_ACTIVE) {
+            if (clear) {
+                state = RULE_IDLE;
+                if (r->cb) r->cb(i, false, rep);
+            }
+        }
+        else if (! cond) {
+            state = RULE_IDLE;
+        }
+        else {
+            if (state == RULE_IDLE) {
+                r->since = now;
+                state = RULE_PENDING;
+            }
+
+            if (now - r->since >= r->duration) {
+                state = RULE_ACTIVE;
+                if (r->cb) r->cb(i, true, rep);
+            }
+        }
+
+        r->state = (r->state & RULE_HAVE_PREV) | state;
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * SVM40 Library threshold / event engine
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Rules are checked on each new sample and a callback is called when a
+ * rule becomes active or is cleared. No samples are kept.
+ *
+ * A rule is :
+ *  SVM40_RULE_ABOVE : value above threshold
+ *  SVM40_RULE_BELOW : value below threshold
+ *  SVM40_RULE_RISE  : value increases faster than threshold per minute
+ *  SVM40_RULE_FALL  : value decreases faster than threshold per minute
+ *
+ * The rate is measured over SVM40_EVENT_WINDOW (1 minute), so a RISE / FALL
+ * rule is checked once per window.
+ *
+ * The condition must be true for at least 'duration' mS before the rule
+ * becomes active. An active rule is cleared once the value (or rate) is back
+ * beyond the threshold with the hysteresis.
+ *
+ * Example : VOC index above 250 for 30 seconds, clear below 230
+ *
+ *   events.AddRule(SVM40_CH_VOC_INDEX, SVM40_RULE_ABOVE, 250, 20, 30000, voc_alarm);
+ *
+ * Example : risk of condensation (less than 2 degrees above dew point)
+ *
+ *   events.AddRule(SVM40_CH_DEW_SPREAD, SVM40_RULE_BELOW, 2, 0.5, 0, dew_alarm);
+ *********************************************************************
+ */
+#ifndef SVM40_EVENT_H
+#define SVM40_EVENT_H
+
+#include "svm40.h"
+
+// maximum number of rules (can be set before including)
+#ifndef SVM40_MAX_RULES
+#define SVM40_MAX_RULES 8
+#endif
+
+// mS over which the rate of RISE / FALL rules is measured
+#ifndef SVM40_EVENT_WINDOW
+#define SVM40_EVENT_WINDOW 60000
+#endif
+
+enum svm40_rule_type {
+    SVM40_RULE_ABOVE = 0,
+    SVM40_RULE_BELOW = 1,
+    SVM40_RULE_RISE = 2,
+    SVM40_RULE_FALL = 3
+};
+
+/**
+ * callback
+ * @param id     : rule id as returned by AddRule()
+ * @param active : true if rule became active, false if cleared
+ * @param value  : value (or rate per minute) that triggered or cleared
+ */
+typedef void (*svm40_event_cb)(uint8_t id, bool active, float value);
+
+class SVM40_Events
+{
+  public:
+
+    SVM40_Events(void);
+
+    /**
+     * @brief : add a rule
+     * @param ch         : channel to check
+     * @param type       : condition
+     * @param threshold  : threshold value (or rate per minute)
+     * @param hysteresis : distance from threshold to clear
+     * @param duration   : mS the condition must be true before active
+     * @param cb         : callback (NULL = none, use IsActive())
+     *
+     * @return :
+     *  rule id or -1 if no space
+     */
+    int8_t AddRule(svm40_channel ch, svm40_rule_type type, float threshold,
+                   float hysteresis, uint32_t duration, svm40_event_cb cb);
+
+    /**
+     * @brief : remove a rule
+     * @param id : rule id as returned by AddRule()
+     */
+    void RemoveRule(uint8_t id);
+
+    /**
+     * @brief : check all rules on a new sample
+     * @param v   : sample as obtained from GetValues()
+     * @param now : timestamp in mS
+     */
+    void Process(struct svm40_values *v, uint32_t now);
+    void Process(struct svm40_values *v) {Process(v, millis());}
+
+    /**
+     * @brief : check whether a rule is active
+     * @param id : rule id as returned by AddRule()
+     */
+    bool IsActive(uint8_t id);
+
+  private:
+
+    struct svm40_rule {
+        svm40_event_cb  cb;
+        float       threshold;
+        float       hysteresis;
+        float       prev;           // value at start of rate window
+        uint32_t    duration;
+        uint32_t    prev_time;      // start of rate window
+        uint32_t    since;          // time condition became true
+        svm40_channel ch;
+        uint8_t     type;
+        uint8_t     state;          // see SVM40_RULE_xxx in svm40_event.cpp
+    };
+
+    svm40_rule  _rules[SVM40_MAX_RULES];
+};
+
+#endif /* SVM40_EVENT_H */
@@ -0,0 +1,146 @@
+/**
+ * SVM40 Library report-by-exception filter
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_filter.h"
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Filter::SVM40_Filter(void) {
+    SetDeadband(SVM40_CH_TEMPERATURE, 0.2);
+    SetDeadband(SVM40_CH_HUMIDITY, 1);
+    SetDeadband(SVM40_CH_VOC_INDEX, 5);
+    SetDeadband(SVM40_CH_RAW_VOC, 0);
+    _heartbeat = 900000;        // 15 minutes
+    _slope = 0;
+    Reset();
+}
+
+/**
+ * @brief : set the deadband of a channel
+ * @param ch       : channel
+ * @param absolute : change to report (zero = not used)
+ * @param relative : change to report in % of last reported value (zero = not used)
+ */
+void SVM40_Filter::SetDeadband(svm40_channel ch, float absolute, float relative) {
+    if (ch >= SVM40_CH_COUNT) return;
+    _abs[ch] = absolute;
+    _rel[ch] = relative;
+}
+
+/**
+ * @brief : maximum time without reporting a sample
+ * @param max_silence : time in mS (zero = disabled)
+ */
+void SVM40_Filter::SetHeartbeat(uint32_t max_silence) {
+    _heartbeat = max_silence;
+}
+
+/**
+ * @brief : report when VOC index changes fast
+ * @param slope : change in VOC index points per minute (zero = disabled)
+ */
+void SVM40_Filter::SetVocSlope(float slope) {
+    _slope = slope;
+}
+
+/**
+ * @brief : report the next sample and reset counters
+ */
+void SVM40_Filter::Reset() {
+    _first = true;
+    _checked = _reported = 0;
+    _reason = 0;
+}
+
+/**
+ * @brief : check whether a sample should be reported
+ * @param v   : sample as obtained from GetValues()
+ * @param now : timestamp in mS
+ *
+ * @return :
+ *  true to report, false to skip
+ */
+bool SVM40_Filter::Check(struct svm40_values *v, uint32_t now) {
+    uint8_t i;
+    float val, diff, voc;
+
+    _checked++;
+    _reason = 0;
+
+    voc = (float) v->VOC_index;
+
+    if (_first) {
+        _reason = SVM40_FILTER_FIRST;
+    }
+    else {
+        for (i = 0; i < SVM40_CH_COUNT; i++) {
+
+            val = svm40_channel_value(v, (svm40_channel) i);
+            diff = fabs(val - _ref[i]);
+
+            if (_abs[i] > 0 && diff >= _abs[i])
+                _reason |= 1 << i;
+
+            // not relative to zero (e.g. 0 degrees), any change would count
+            else if (_rel[i] > 0 && _ref[i] != 0 && diff * 100 >= _rel[i] * fabs(_ref[i]))
+                _reason |= 1 << i;
+        }
+
+        if (_heartbeat > 0 && now - _sent_time >= _heartbeat)
+            _reason |= SVM40_FILTER_HEARTBEAT;
+
+        // VOC index points per minute over the window. Sample to sample
+        // a step of 1 point at 1 Hz would be 60 points per minute
+        if (now - _win_time >= SVM40_FILTER_WINDOW) {
+
+            if (_slope > 0 && fabs(voc - _win_voc) * 60000 >= _slope * (float) (now - _win_time))
+                _reason |= SVM40_FILTER_SLOPE;
+
+            _win_voc = voc;
+            _win_time = now;
+        }
+    }
+
+    if (_first) {
+        _win_voc = voc;
+        _win_time = now;
+    }
+
+    if (_reason == 0) return(false);
+
+    for (i = 0; i < SVM40_CH_COUNT; i++)
+        _ref[i] = svm40_channel_value(v, (svm40_channel) i);
+
+    _sent_time = now;
+    _first = false;
+    _reported++;
+
+    return(true);
+}
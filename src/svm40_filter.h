@@ -0,0 +1,137 @@
+/**
+ * SVM40 Library report-by-exception filter
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Decides whether a sample is worth sending (e.g. over a radio uplink).
+ * A sample is reported if :
+ *  - a channel changed more than its deadband since the last reported sample
+ *    (absolute and/or relative in % of the last reported value, the relative
+ *    deadband is not used while the last reported value is zero)
+ *  - the VOC index changes faster than the slope trigger (points per minute,
+ *    measured over SVM40_FILTER_WINDOW)
+ *  - no sample was reported for the heartbeat time (bounds staleness)
+ *  - it is the first sample
+ *
+ * Defaults :
+ *  temperature 0.2 degrees, humidity 1 %RH, VOC index 5 points,
+ *  raw VOC ticks disabled, heartbeat 15 minutes, slope disabled.
+ *
+ *   if (svm40.GetValues(&v) == ERR_OK && filter.Check(&v)) send(&v);
+ *********************************************************************
+ */
+#ifndef SVM40_FILTER_H
+#define SVM40_FILTER_H
+
+#include "svm40.h"
+
+// reasons a sample was reported (GetReason())
+#define SVM40_FILTER_DEADBAND   0x0F    // bit per channel (1 << svm40_channel)
+#define SVM40_FILTER_HEARTBEAT  0x10
+#define SVM40_FILTER_SLOPE      0x20
+#define SVM40_FILTER_FIRST      0x40
+
+#define SVM40_FILTER_WINDOW     60000   // mS over which the VOC slope is measured
+
+class SVM40_Filter
+{
+  public:
+
+    SVM40_Filter(void);
+
+    /**
+     * @brief : set the deadband of a channel
+     * @param ch       : channel
+     * @param absolute : change to report (zero = not used)
+     * @param relative : change to report in % of last reported value (zero = not used)
+     *
+     * If both are zero, the channel is not checked.
+     */
+    void SetDeadband(svm40_channel ch, float absolute, float relative = 0);
+
+    /**
+     * @brief : maximum time without reporting a sample
+     * @param max_silence : time in mS (zero = disabled)
+     */
+    void SetHeartbeat(uint32_t max_silence);
+
+    /**
+     * @brief : report when VOC index changes fast
+     * @param slope : change in VOC index points per minute (zero = disabled)
+     *
+     * The change is measured over SVM40_FILTER_WINDOW, so a fast change is
+     * reported up to a window later.
+     */
+    void SetVocSlope(float slope);
+
+    /**
+     * @brief : check whether a sample should be reported
+     * @param v   : sample as obtained from GetValues()
+     * @param now : timestamp in mS
+     *
+     * If reported, the sample becomes the reference for the deadbands.
+     *
+     * @return :
+     *  true to report, false to skip
+     */
+    bool Check(struct svm40_values *v, uint32_t now);
+    bool Check(struct svm40_values *v) {return(Check(v, millis()));}
+
+    /**
+     * @brief : reason(s) the last checked sample was reported
+     *
+     * @return :
+     *  combination of SVM40_FILTER_xxx or zero if not reported
+     */
+    uint8_t GetReason() {return(_reason);}
+
+    /**
+     * @brief : number of samples checked and reported
+     */
+    uint32_t GetChecked()  {return(_checked);}
+    uint32_t GetReported() {return(_reported);}
+
+    /**
+     * @brief : report the next sample and reset counters
+     */
+    void Reset();
+
+  private:
+
+    float     _abs[SVM40_CH_COUNT];     // absolute deadband per channel
+    float     _rel[SVM40_CH_COUNT];     // relative deadband per channel (%)
+    float     _ref[SVM40_CH_COUNT];     // last reported values
+    float     _slope;                   // VOC index points per minute
+    float     _win_voc;                 // VOC index at start of slope window
+    uint32_t  _win_time;                // start of slope window
+    uint32_t  _sent_time;               // time of last reported sample
+    uint32_t  _heartbeat;               // max time between reports
+    uint32_t  _checked;
+    uint32_t  _reported;
+    uint8_t   _reason;
+    bool      _first;                   // nothing reported yet
+};
+
+#endif /* SVM40_FILTER_H */
@@ -0,0 +1,250 @@
+/**
+ * SVM40 Library sample history
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * A ring buffer of samples as received from the sensor (svm40_raw, 12 bytes)
+ * with the time since the previous sample (2 bytes). This takes 14 bytes
+ * per sample instead of the 40 bytes of a struct svm40_values.
+ *
+ * The capacity is set at compile time:
+ *
+ *   SVM40_History<300> hist(12);   // keep every 12th sample, 300 samples
+ *                                  // = 1 hour at 1Hz in 4200 bytes
+ *
+ * Keeping a full hour of 1Hz samples takes 3600 * 14 = 50400 bytes. That
+ * will not fit in a MEGA2560 (8K) so use the decimation to thin out.
+ *
+ * The time between 2 stored samples is kept in units of 100 mS
+ * (SVM40_HISTORY_TICK), up to 1.8 hours. The rounding is carried to the
+ * next sample, so the rebuilt timestamps are within 50 mS of the real
+ * ones, however long the history. A longer gap can not be stored : the
+ * timestamps of the samples before it are then an estimate and marked as
+ * not exact (svm40_sample.exact).
+ *********************************************************************
+ */
+#ifndef SVM40_HISTORY_H
+#define SVM40_HISTORY_H
+
+#include "svm40.h"
+
+#define SVM40_HISTORY_TICK  100         // mS per unit of the stored time delta
+#define SVM40_HISTORY_GAP   0xffff      // delta too long to store
+
+// a decoded history entry
+struct svm40_sample
+{
+    uint32_t   time;               // millis() at the time the sample was added
+    svm40_raw  raw;                // sample as received from the sensor
+    bool       exact;              // false : a longer gap follows, time is an estimate
+};
+
+template <uint16_t N>
+class SVM40_History
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param decimate : store every x-th sample that is added (1 = all)
+     */
+    SVM40_History(uint8_t decimate = 1) {
+        _decimate = decimate == 0 ? 1 : decimate;
+        Clear();
+    }
+
+    /**
+     * @brief remove all samples
+     */
+    void Clear() {
+        _head = _count = 0;
+        _skip = 0;
+        _last = 0;
+    }
+
+    /**
+     * @brief : add a sample
+     * @param r   : sample as obtained from GetRawValues()
+     * @param now : timestamp in mS
+     *
+     * @return :
+     *  true if stored, false if skipped because of decimation
+     */
+    bool Add(struct svm40_raw *r, uint32_t now) {
+        uint32_t ticks;
+
+        if (_skip > 0) {
+            _skip--;
+            return(false);
+        }
+        _skip = _decimate - 1;
+
+        if (_count == 0) {
+            ticks = 0;
+            _last = now;
+        }
+        else {
+            // rounded, the rounding is carried to the next sample
+            ticks = (now - _last + SVM40_HISTORY_TICK / 2) / SVM40_HISTORY_TICK;
+
+            if (ticks >= SVM40_HISTORY_GAP) {
+                ticks = SVM40_HISTORY_GAP;
+                _last = now;
+            }
+            else
+                _last += ticks * SVM40_HISTORY_TICK;
+        }
+
+        // full : the oldest is dropped
+        if (_count < N) _count++;
+
+        _raw[_head] = *r;
+        _delta[_head] = (uint16_t) ticks;
+
+        if (++_head == N) _head = 0;
+
+        return(true);
+    }
+
+    bool Add(struct svm40_raw *r) {return(Add(r, millis()));}
+
+    /**
+     * @brief : number of samples stored / that can be stored
+     */
+    uint16_t Count()    {return(_count);}
+    uint16_t Capacity() {return(N);}
+
+    /**
+     * @brief : get a sample
+     * @param idx : 0 is the oldest, Count() - 1 the newest
+     * @param s   : pointer to store the sample
+     *
+     * The timestamp is rebuild from the newest sample, this takes more time
+     * for a lower index. Use the iterator to walk all samples.
+     *
+     * @return :
+     *  true if available else false
+     */
+    bool Get(uint16_t idx, struct svm40_sample *s) {
+        uint16_t i, pos, gaps = 0;
+
+        if (idx >= _count) return(false);
+
+        pos = Newest();
+        s->time = _last;
+
+        for (i = _count - 1; i > idx; i--) {
+            if (_delta[pos] == SVM40_HISTORY_GAP) gaps++;
+            s->time -= (uint32_t) _delta[pos] * SVM40_HISTORY_TICK;
+            pos = pos == 0 ? N - 1 : pos - 1;
+        }
+
+        s->raw = _raw[pos];
+        s->exact = gaps == 0;
+        return(true);
+    }
+
+    /**
+     * iterator from the oldest to the newest sample
+     *
+     *   for (svm40_sample s : hist) { ... }
+     */
+    class Iterator
+    {
+      public:
+        Iterator(SVM40_History *h, uint16_t n) : _h(h), _n(n) {
+            _pos = h->Oldest();
+            if (_n < h->_count) {
+                _s.time = h->Start(&_gaps);
+                _s.raw = h->_raw[_pos];
+                _s.exact = _gaps == 0;
+            }
+        }
+
+        const svm40_sample& operator*() const {return(_s);}
+        const svm40_sample* operator->() const {return(&_s);}
+        bool operator!=(const Iterator &o) const {return(_n != o._n);}
+
+        Iterator& operator++() {
+            if (++_n < _h->_count) {
+                if (++_pos == N) _pos = 0;
+                if (_h->_delta[_pos] == SVM40_HISTORY_GAP) _gaps--;
+                _s.time += (uint32_t) _h->_delta[_pos] * SVM40_HISTORY_TICK;
+                _s.raw = _h->_raw[_pos];
+                _s.exact = _gaps == 0;
+            }
+            return(*this);
+        }
+
+      private:
+        SVM40_History *_h;
+        uint16_t      _n;             // samples handled
+        uint16_t      _pos;           // position in the ring
+        uint16_t      _gaps;          // gaps after this sample
+        svm40_sample  _s;             // decoded sample
+    };
+
+    Iterator begin() {return(Iterator(this, 0));}
+    Iterator end()   {return(Iterator(this, _count));}
+
+  private:
+
+    uint16_t Oldest() {
+        return(_count == N ? _head : 0);
+    }
+
+    uint16_t Newest() {
+        return(_head == 0 ? N - 1 : _head - 1);
+    }
+
+    /**
+     * @brief : time of the oldest sample, rebuild from the newest
+     * @param gaps : to store the number of gaps after the oldest sample
+     */
+    uint32_t Start(uint16_t *gaps) {
+        uint32_t t = _last;
+        uint16_t i, pos = Newest();
+
+        *gaps = 0;
+
+        for (i = 1; i < _count; i++) {
+            if (_delta[pos] == SVM40_HISTORY_GAP) (*gaps)++;
+            t -= (uint32_t) _delta[pos] * SVM40_HISTORY_TICK;
+            pos = pos == 0 ? N - 1 : pos - 1;
+        }
+
+        return(t);
+    }
+
+    svm40_raw _raw[N];                // samples
+    uint16_t  _delta[N];              // SVM40_HISTORY_TICK since previous sample
+    uint16_t  _head;                  // next position to write
+    uint16_t  _count;                 // samples stored
+    uint32_t  _last;                  // time of the newest sample (rounded)
+    uint8_t   _decimate;              // store every x-th sample
+    uint8_t   _skip;                  // samples to skip before next store
+};
+
+#endif /* SVM40_HISTORY_H */
@@ -0,0 +1,190 @@
+/**
+ * SVM40 Library duty-cycled acquisition
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * See svm40_scheduler.h
+ *********************************************************************
+ */
+
+#include "svm40_scheduler.h"
+
+/**
+ * @brief constructor
+ */
+SVM40_Scheduler::SVM40_Scheduler(void) {
+    _svm = NULL;
+    _sleep = NULL;
+    _period = SVM40_SCH_CADENCE;
+    memset(&_power, 0x0, sizeof(_power));
+    ClearEnergy();
+}
+
+/**
+ * @brief : set the sleep routine
+ */
+void SVM40_Scheduler::SetSleep(svm40_wait_cb cb, void *arg) {
+    _sleep = cb;
+    _sleep_arg = arg;
+}
+
+/**
+ * @brief : start the measurement and the schedule
+ * @param s     : SVM40 driver
+ * @param every : read every x-th sample of the sensor
+ *
+ * @return :
+ *  true if the measurement is started, else false
+ */
+bool SVM40_Scheduler::begin(SVM40 *s, uint16_t every) {
+    bool ret;
+
+    if (every == 0) every = 1;
+    if (every > 3600) every = 3600;     // micros() wraps after 71 minutes
+
+    _svm = s;
+    _period = (uint32_t) every * SVM40_SCH_CADENCE;
+
+    // the driver sleeps while waiting for the sensor
+    _svm->SetWait(Sleep, this);
+
+    ret = _svm->start();
+
+    // first sample when the sensor is ready
+    _next = millis() + _svm->GetReadyIn() + SVM40_SCH_PHASE;
+
+    ClearEnergy();
+    return(ret);
+}
+
+/**
+ * @brief : mS until the next sample instant
+ *
+ * @return :
+ *  mS left (0 = due)
+ */
+uint32_t SVM40_Scheduler::TimeToNext() {
+    int32_t left = (int32_t) (_next - millis());
+
+    return(left > 0 ? (uint32_t) left : 0);
+}
+
+/**
+ * @brief : sleep until the next sample instant and read the sample
+ * @param v : to store the values
+ *
+ * @return :
+ *  ERR_OK = ok else error
+ */
+uint8_t SVM40_Scheduler::loop(struct svm40_values *v) {
+    uint32_t left;
+    uint8_t ret;
+
+    if (_svm == NULL) return(ERR_PARAMETER);
+
+    // the sleep routine may return earlier (e.g. interrupt)
+    while ((left = TimeToNext()) > 0) Sleep(this, left);
+
+    ret = _svm->GetValues(v);
+
+    if (ret == ERR_OK) _e.samples++;
+    else _e.errors++;
+
+    // next instant that is still to come
+    _next += _period;
+
+    while ((int32_t) (millis() - _next) >= 0) {
+        _next += _period;
+        _e.missed++;
+    }
+
+    Account();
+    return(ret);
+}
+
+/**
+ * @brief : sleep routine, also used by the driver (SetWait())
+ * @param arg : the scheduler
+ * @param ms  : mS to sleep
+ */
+void SVM40_Scheduler::Sleep(void *arg, uint32_t ms) {
+    SVM40_Scheduler *s = (SVM40_Scheduler *) arg;
+    uint32_t st = micros();
+
+    if (s->_sleep) s->_sleep(s->_sleep_arg, ms);
+    else delay(ms);
+
+    s->_slept_us += micros() - st;
+}
+
+/**
+ * @brief : add the time since the last call as active and sleep time
+ */
+void SVM40_Scheduler::Account() {
+    uint32_t now = micros();
+    uint32_t elapsed = now - _last;
+
+    _last = now;
+
+    if (_slept_us > elapsed) _slept_us = elapsed;
+
+    _active_rem += elapsed - _slept_us;
+    _sleep_rem += _slept_us;
+    _slept_us = 0;
+
+    _e.active_ms += _active_rem / 1000;
+    _active_rem %= 1000;
+    _e.sleep_ms += _sleep_rem / 1000;
+    _sleep_rem %= 1000;
+}
+
+/**
+ * @brief : get the energy estimate
+ */
+void SVM40_Scheduler::GetEnergy(struct svm40_energy *e) {
+    float active_h, sleep_h;
+
+    Account();
+    *e = _e;
+
+    active_h = e->active_ms / 3600000.0;
+    sleep_h = e->sleep_ms / 3600000.0;
+
+    if (active_h + sleep_h <= 0) return;
+
+    e->duty = active_h / (active_h + sleep_h);
+    e->charge_mah = _power.active_ma * active_h + _power.sleep_ua / 1000.0 * sleep_h
+                    + _power.sensor_ma * (active_h + sleep_h);
+    e->avg_ma = e->charge_mah / (active_h + sleep_h);
+}
+
+/**
+ * @brief : clear the energy estimate
+ */
+void SVM40_Scheduler::ClearEnergy() {
+    memset(&_e, 0x0, sizeof(_e));
+    _last = micros();
+    _slept_us = _active_rem = _sleep_rem = 0;
+}
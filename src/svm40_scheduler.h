@@ -0,0 +1,159 @@
+/**
+ * SVM40 Library duty-cycled acquisition
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * The SVM40 keeps measuring (so the VOC algorithm keeps learning) and has
+ * a new sample every second after start(). SVM40_Scheduler reads a sample
+ * every x-th second and sleeps in between, also while the driver waits for
+ * the answer of the sensor :
+ *
+ *   SVM40_Scheduler sch;
+ *   sch.SetSleep(my_sleep);             // e.g. sleep until an interrupt
+ *   sch.begin(&svm40, 10);              // read every 10th second
+ *
+ *   loop() {
+ *     if (sch.loop(&v) == ERR_OK) ...   // sleeps until the next sample
+ *   }
+ *
+ * The sample instants are counted from the moment the sensor is ready
+ * after start(), plus SVM40_SCH_PHASE to be clear of the update of the
+ * sensor. If a sample instant is missed (e.g. the program was busy) the
+ * next one in the future is taken and counted as missed.
+ *
+ * The sleep routine (see svm40_wait_cb in svm40.h) is set as wait routine
+ * of the driver (SetWait()). It must return when the time has passed or
+ * earlier, e.g. on an interrupt. Default is delay().
+ *
+ * The time spent in the sleep routine is counted as sleep, all other time
+ * as active. With the currents of the MCU and sensor (SetPower()) the
+ * charge used and the average current are estimated (GetEnergy()).
+ *
+ * On a host (extras/host) delay() advances the virtual clock, so a day of
+ * samples takes a fraction of a second (see extras/duty).
+ *********************************************************************
+ */
+#ifndef SVM40_SCHEDULER_H
+#define SVM40_SCHEDULER_H
+
+#include "svm40.h"
+
+#define SVM40_SCH_CADENCE   1000            // mS between samples of the sensor
+#define SVM40_SCH_PHASE     200             // mS after the sample of the sensor
+
+// currents to estimate the energy
+struct svm40_power
+{
+    float      active_ma;          // MCU active
+    float      sleep_ua;           // MCU sleeping
+    float      sensor_ma;          // SVM40 measuring
+};
+
+// energy estimate (since begin() or ClearEnergy())
+struct svm40_energy
+{
+    uint32_t   samples;            // samples read
+    uint32_t   errors;             // reads that failed
+    uint32_t   missed;             // sample instants missed
+    uint32_t   active_ms;          // time active
+    uint32_t   sleep_ms;           // time in the sleep routine
+    float      duty;               // active / (active + sleep)
+    float      charge_mah;         // charge used (SetPower())
+    float      avg_ma;             // average current
+};
+
+class SVM40_Scheduler
+{
+  public:
+
+    SVM40_Scheduler(void);
+
+    /**
+     * @brief : set the sleep routine (call before begin())
+     * @param cb  : routine to call (NULL = delay())
+     * @param arg : passed to the routine
+     */
+    void SetSleep(svm40_wait_cb cb, void *arg = NULL);
+
+    /**
+     * @brief : set the currents for the energy estimate
+     */
+    void SetPower(struct svm40_power *p) {_power = *p;}
+
+    /**
+     * @brief : start the measurement and the schedule
+     * @param s     : SVM40 driver, begun on the port
+     * @param every : read every x-th sample of the sensor (1 = every second,
+     *                maximum 3600)
+     *
+     * The measurement must not be started yet, as starting again would
+     * restart the VOC algorithm.
+     * @return :
+     *  true if the measurement is started, else false
+     */
+    bool begin(SVM40 *s, uint16_t every = 1);
+
+    /**
+     * @brief : sleep until the next sample instant and read the sample
+     * @param v : to store the values
+     *
+     * @return :
+     *  ERR_OK = ok else error of GetValues()
+     */
+    uint8_t loop(struct svm40_values *v);
+
+    /**
+     * @brief : mS until the next sample instant (0 = due), for a program
+     * that sleeps itself and calls loop() when it is due
+     */
+    uint32_t TimeToNext();
+
+    /**
+     * @brief : get / clear the energy estimate
+     */
+    void GetEnergy(struct svm40_energy *e);
+    void ClearEnergy();
+
+  private:
+
+    static void Sleep(void *arg, uint32_t ms);
+    void     Account();
+
+    SVM40    *_svm;
+    svm40_wait_cb _sleep;           // sleep routine (NULL = delay())
+    void     *_sleep_arg;
+    struct svm40_power _power;
+    uint32_t _period;               // mS between reads
+    uint32_t _next;                 // millis() of the next read
+
+    // energy
+    struct svm40_energy _e;
+    uint32_t _last;                 // micros() of last Account()
+    uint32_t _slept_us;             // slept since last Account()
+    uint32_t _active_rem;           // uS not yet in _e.active_ms
+    uint32_t _sleep_rem;            // uS not yet in _e.sleep_ms
+};
+
+#endif /* SVM40_SCHEDULER_H */
@@ -0,0 +1,149 @@
+/**
+ * SVM40 Library window aggregation
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_stats.h"
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_Aggregator::SVM40_Aggregator(uint32_t window) {
+    _window = window == 0 ? 1 : window;
+    Clear();
+}
+
+/**
+ * @brief : remove all data of current and finished window
+ */
+void SVM40_Aggregator::Clear() {
+    _count = 0;
+    _available = false;
+}
+
+/**
+ * @brief : add a sample
+ * @param v   : sample as obtained from GetValues()
+ * @param now : timestamp in mS
+ *
+ * Mean and variance are updated with Welford's method.
+ *
+ * @return :
+ *  true if the previous window has finished
+ */
+bool SVM40_Aggregator::Add(struct svm40_values *v, uint32_t now) {
+    bool finished = false;
+    uint32_t index = now / _window;
+    uint8_t i;
+    float val, delta;
+
+    // sample for next window ?
+    if (_count > 0 && index != _index) {
+        Finish();
+        finished = true;
+    }
+
+    if (_count == 0) {
+        _index = index;
+        _first = now;
+    }
+
+    _last = now;
+    _count++;
+
+    for (i = 0; i < SVM40_CH_COUNT; i++) {
+
+        val = svm40_channel_value(v, (svm40_channel) i);
+
+        if (_count == 1) {
+            _ch[i].min = _ch[i].max = _ch[i].mean = val;
+            _ch[i].m2 = 0;
+            continue;
+        }
+
+        if (val < _ch[i].min) _ch[i].min = val;
+        if (val > _ch[i].max) _ch[i].max = val;
+
+        delta = val - _ch[i].mean;
+        _ch[i].mean += delta / _count;
+        _ch[i].m2 += delta * (val - _ch[i].mean);
+    }
+
+    return(finished);
+}
+
+/**
+ * @brief : close the current window now
+ *
+ * @return :
+ *  true if the summary is available
+ */
+bool SVM40_Aggregator::Flush() {
+
+    if (_count == 0) return(false);
+
+    Finish();
+    return(true);
+}
+
+/**
+ * @brief : store the summary of the current window and start a new window
+ */
+void SVM40_Aggregator::Finish() {
+    uint8_t i;
+
+    _summary.first = _first;
+    _summary.last = _last;
+    _summary.count = _count;
+
+    for (i = 0; i < SVM40_CH_COUNT; i++) {
+        _summary.ch[i].min = _ch[i].min;
+        _summary.ch[i].max = _ch[i].max;
+        _summary.ch[i].mean = _ch[i].mean;
+
+        if (_count > 1) _summary.ch[i].stddev = sqrt(_ch[i].m2 / (_count - 1));
+        else _summary.ch[i].stddev = 0;
+    }
+
+    _available = true;
+    _count = 0;
+}
+
+/**
+ * @brief : get the summary of the last finished window
+ * @param s : pointer to store summary
+ *
+ * @return :
+ *  true if available else false
+ */
+bool SVM40_Aggregator::GetSummary(struct svm40_summary *s) {
+
+    if (! _available) return(false);
+
+    *s = _summary;
+    return(true);
+}
@@ -0,0 +1,130 @@
+/**
+ * SVM40 Library window aggregation
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * Calculates per channel (temperature, humidity, VOC index, raw VOC ticks)
+ * the minimum, maximum, mean and standard deviation over a time window
+ * without keeping the samples. Each new sample is added with Add(). When a
+ * sample falls in a next window, the summary of the finished window is
+ * available with GetSummary().
+ *
+ * For multiple window sizes create an aggregator for each:
+ *
+ *   SVM40_Aggregator agg_1m(60000), agg_15m(900000), agg_1h(3600000);
+ *
+ * Windows are aligned on multiples of the window size of the timestamp
+ * that is provided (e.g. millis() or epoch mS)
+ *********************************************************************
+ */
+#ifndef SVM40_STATS_H
+#define SVM40_STATS_H
+
+#include "svm40.h"
+
+// result of a channel
+struct svm40_chan_stat
+{
+    float      min;
+    float      max;
+    float      mean;
+    float      stddev;              // sample standard deviation (zero if count < 2)
+};
+
+// result of a window
+struct svm40_summary
+{
+    uint32_t   first;               // timestamp of the first sample in window
+    uint32_t   last;                // timestamp of the last sample in window
+    uint32_t   count;               // number of samples in window
+    svm40_chan_stat ch[SVM40_CH_COUNT]; // per channel (index svm40_channel)
+};
+
+class SVM40_Aggregator
+{
+  public:
+
+    /**
+     * @brief constructor
+     * @param window : window size in mS
+     */
+    SVM40_Aggregator(uint32_t window);
+
+    /**
+     * @brief : add a sample
+     * @param v   : sample as obtained from GetValues()
+     * @param now : timestamp in mS
+     *
+     * @return :
+     *  true if this sample finished the previous window. The summary
+     *  is available with GetSummary().
+     */
+    bool Add(struct svm40_values *v, uint32_t now);
+    bool Add(struct svm40_values *v) {return(Add(v, millis()));}
+
+    /**
+     * @brief : close the current window now (e.g. before sleep or upload)
+     *
+     * @return :
+     *  true if the window had samples and the summary is available
+     */
+    bool Flush();
+
+    /**
+     * @brief : get the summary of the last finished window
+     * @param s : pointer to store summary
+     *
+     * @return :
+     *  true if available else false
+     */
+    bool GetSummary(struct svm40_summary *s);
+
+    /**
+     * @brief : remove all data of current and finished window
+     */
+    void Clear();
+
+  private:
+
+    struct svm40_welford {
+        float  min;
+        float  max;
+        float  mean;
+        float  m2;                  // sum of squares of differences from mean
+    };
+
+    void Finish();
+
+    uint32_t  _window;              // window size in mS
+    uint32_t  _index;               // window number of current window
+    uint32_t  _first;               // first sample in current window
+    uint32_t  _last;                // last sample in current window
+    uint32_t  _count;               // samples in current window
+    bool      _available;           // summary is available
+    svm40_welford  _ch[SVM40_CH_COUNT];
+    svm40_summary  _summary;        // last finished window
+};
+
+#endif /* SVM40_STATS_H */
@@ -0,0 +1,665 @@
+/**
+ * SVM40 Library VOC index algorithm
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Based on the Sensirion VOC index algorithm (sensirion_voc_algorithm.c)
+ * Copyright (c) 2021, Sensirion AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of Sensirion AG nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *********************************************************************
+ */
+
+#include "svm40_voc_algorithm.h"
+
+/* algorithm constants */
+#define VocAlgorithm_SAMPLING_INTERVAL (1.)
+#define VocAlgorithm_INITIAL_BLACKOUT (45.)
+#define VocAlgorithm_VOC_INDEX_GAIN (230.)
+#define VocAlgorithm_SRAW_STD_INITIAL (50.)
+#define VocAlgorithm_SRAW_STD_BONUS (220.)
+#define VocAlgorithm_TAU_MEAN_VARIANCE_HOURS (12.)
+#define VocAlgorithm_TAU_INITIAL_MEAN (20.)
+#define VocAlgorithm_INIT_DURATION_MEAN ((3600. * 0.75))
+#define VocAlgorithm_INIT_TRANSITION_MEAN (0.01)
+#define VocAlgorithm_TAU_INITIAL_VARIANCE (2500.)
+#define VocAlgorithm_INIT_DURATION_VARIANCE ((3600. * 1.45))
+#define VocAlgorithm_INIT_TRANSITION_VARIANCE (0.01)
+#define VocAlgorithm_GATING_THRESHOLD (340.)
+#define VocAlgorithm_GATING_THRESHOLD_INITIAL (510.)
+#define VocAlgorithm_GATING_THRESHOLD_TRANSITION (0.09)
+#define VocAlgorithm_GATING_MAX_DURATION_MINUTES ((60. * 3.))
+#define VocAlgorithm_GATING_MAX_RATIO (0.3)
+#define VocAlgorithm_SIGMOID_L (500.)
+#define VocAlgorithm_SIGMOID_K (-0.0065)
+#define VocAlgorithm_SIGMOID_X0 (213.)
+#define VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT (100.)
+#define VocAlgorithm_LP_TAU_FAST (20.0)
+#define VocAlgorithm_LP_TAU_SLOW (500.0)
+#define VocAlgorithm_LP_ALPHA (-0.2)
+#define VocAlgorithm_PERSISTENCE_UPTIME_GAMMA ((3. * 3600.))
+#define VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING (64.)
+#define VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__FIX16_MAX (32767.)
+
+/*******************************************************************
+ *  FIXED POINT 16.16 ROUTINES (derived from libfixmath)
+ *******************************************************************/
+#define FIX16_MAXIMUM 0x7FFFFFFF
+#define FIX16_MINIMUM 0x80000000
+#define FIX16_OVERFLOW 0x80000000
+#define FIX16_ONE 0x00010000
+
+/* convert a constant (evaluated at compile time) */
+#define F16(x) ((fix16_t)(((x) >= 0) ? ((x)*65536.0 + 0.5) : ((x)*65536.0 - 0.5)))
+
+static inline fix16_t fix16_from_int(int32_t a) {
+    return a * FIX16_ONE;
+}
+
+static inline int32_t fix16_cast_to_int(fix16_t a) {
+    return (a >= 0) ? (a >> 16) : -((-a) >> 16);
+}
+
+#if defined(__AVR__)
+
+/**
+ * @brief : multiply with rounding, 32 bit only
+ */
+static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
+    // Each argument is divided to 16-bit parts.
+    //          AB
+    //      *   CD
+    // -----------
+    //          BD  16 * 16 -> 32 bit products
+    //         CB
+    //         AD
+    //        AC
+    //       |----| 64 bit product
+    int32_t A = (inArg0 >> 16), C = (inArg1 >> 16);
+    uint32_t B = (inArg0 & 0xFFFF), D = (inArg1 & 0xFFFF);
+
+    int32_t AC = A * C;
+    int32_t AD_CB = A * D + C * B;
+    uint32_t BD = B * D;
+
+    int32_t product_hi = AC + (AD_CB >> 16);
+
+    // Handle carry from lower 32 bits to upper part of result.
+    uint32_t ad_cb_temp = AD_CB << 16;
+    uint32_t product_lo = BD + ad_cb_temp;
+    if (product_lo < BD) product_hi++;
+
+    // The upper 17 bits should all be the same (the sign).
+    if (product_hi >> 31 != product_hi >> 15) return FIX16_OVERFLOW;
+
+    // Subtracting 0x8000 (= 0.5) and then using signed right shift
+    // achieves proper rounding to result-1, except in the corner
+    // case of negative numbers and lowest word = 0x8000.
+    // To handle that, we also have to subtract 1 for negative numbers.
+    uint32_t product_lo_tmp = product_lo;
+    product_lo -= 0x8000;
+    product_lo -= (uint32_t)product_hi >> 31;
+    if (product_lo > product_lo_tmp) product_hi--;
+
+    // Discard the lowest 16 bits. Note that this is not exactly the same
+    // as dividing by 0x10000. For example if product = -1, result will
+    // also be -1 and not 0. This is compensated by adding +1 to the result
+    // and compensating this in turn in the rounding above.
+    fix16_t result = (product_hi << 16) | (product_lo >> 16);
+    result += 1;
+    return result;
+}
+
+/**
+ * @brief : divide with rounding (binary restoring division)
+ */
+static fix16_t fix16_div(fix16_t a, fix16_t b) {
+
+    if (b == 0) return FIX16_MINIMUM;
+
+    uint32_t remainder = (a >= 0) ? a : (-a);
+    uint32_t divider = (b >= 0) ? b : (-b);
+
+    uint32_t quotient = 0;
+    uint32_t bit = 0x10000;
+
+    // The algorithm requires D >= R
+    while (divider < remainder) {
+        divider <<= 1;
+        bit <<= 1;
+    }
+
+    if (!bit) return FIX16_OVERFLOW;
+
+    if (divider & 0x80000000) {
+        // Perform one step manually to avoid overflows later.
+        // We know that divider's bottom bit is 0 here.
+        if (remainder >= divider) {
+            quotient |= bit;
+            remainder -= divider;
+        }
+        divider >>= 1;
+        bit >>= 1;
+    }
+
+    // Main division loop
+    while (bit && remainder) {
+        if (remainder >= divider) {
+            quotient |= bit;
+            remainder -= divider;
+        }
+
+        remainder <<= 1;
+        bit >>= 1;
+    }
+
+    if (remainder >= divider) quotient++;
+
+    fix16_t result = quotient;
+
+    // Figure out the sign of result
+    if ((a ^ b) & 0x80000000) {
+        if (result == (fix16_t) FIX16_MINIMUM) return FIX16_OVERFLOW;
+        result = -result;
+    }
+
+    return result;
+}
+
+#else  // 64 bit arithmetic available
+
+/**
+ * The same rounding and overflow as the 32 bit routines above, using
+ * 64 bit products (much faster on a host or 32 bit MCU). For all values
+ * that occur in the algorithm the result is identical.
+ */
+static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
+    int64_t product = (int64_t) inArg0 * inArg1;
+
+    // The upper 17 bits should all be the same (the sign).
+    if ((product >> 47) != (product >> 63)) return FIX16_OVERFLOW;
+
+    // round half away from zero like the 32 bit routine
+    return (fix16_t) ((product + 0x8000 - (product < 0)) >> 16);
+}
+
+static fix16_t fix16_div(fix16_t a, fix16_t b) {
+    uint64_t remainder, divider, quotient;
+    fix16_t result;
+
+    if (b == 0) return FIX16_MINIMUM;
+
+    remainder = (a >= 0) ? (uint32_t) a : (uint32_t) (-(int64_t) a);
+    divider = (b >= 0) ? (uint32_t) b : (uint32_t) (-(int64_t) b);
+
+    if (remainder > (divider << 15)) return FIX16_OVERFLOW;
+
+    quotient = (remainder << 16) / divider;
+    remainder = (remainder << 16) % divider;
+
+    // round half up
+    if (remainder && remainder * 2 >= divider) quotient++;
+
+    result = (fix16_t) (uint32_t) quotient;
+
+    // Figure out the sign of result
+    if ((a ^ b) & 0x80000000) {
+        if (result == (fix16_t) FIX16_MINIMUM) return FIX16_OVERFLOW;
+        result = -result;
+    }
+
+    return result;
+}
+
+#endif // __AVR__
+
+/**
+ * @brief : square root (x is not negative)
+ */
+static fix16_t fix16_sqrt(fix16_t x) {
+    uint32_t num = x;
+    uint32_t result = 0;
+    uint32_t bit;
+    uint8_t n;
+
+    bit = (uint32_t)1 << 30;
+    while (bit > num) bit >>= 2;
+
+    // The main part is executed twice, in order to avoid
+    // using 64 bit values in computations.
+    for (n = 0; n < 2; n++) {
+
+        // First we get the top 24 bits of the answer.
+        while (bit) {
+            if (num >= result + bit) {
+                num -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result = (result >> 1);
+            }
+            bit >>= 2;
+        }
+
+        if (n == 0) {
+            // Then process it again to get the lowest 8 bits.
+            if (num > 65535) {
+                // The remainder 'num' is too large to be shifted left
+                // by 16, so we have to add 1 to result manually and
+                // adjust 'num' accordingly.
+                // num = a - (result + 0.5)^2
+                //   = num + result^2 - (result + 0.5)^2
+                //   = num - result - 0.5
+                num -= result;
+                num = (num << 16) - 0x8000;
+                result = (result << 16) + 0x8000;
+            } else {
+                num <<= 16;
+                result <<= 16;
+            }
+
+            bit = 1 << 14;
+        }
+    }
+
+    // Finally, if next bit would have been 1, round the result upwards.
+    if (num > result) result++;
+
+    return (fix16_t) result;
+}
+
+/**
+ * @brief : exponent, optimized for size more than speed
+ */
+static fix16_t fix16_exp(fix16_t x) {
+    // exp(x) for x = +/- {1, 1/8, 1/64, 1/512}
+#define NUM_EXP_VALUES 4
+    static const fix16_t exp_pos_values[NUM_EXP_VALUES] = {
+        F16(2.7182818), F16(1.1331485), F16(1.0157477), F16(1.0019550)};
+    static const fix16_t exp_neg_values[NUM_EXP_VALUES] = {
+        F16(0.3678794), F16(0.8824969), F16(0.9844964), F16(0.9980488)};
+    const fix16_t* exp_values;
+
+    fix16_t res, arg;
+    uint16_t i;
+
+    if (x >= F16(10.3972)) return FIX16_MAXIMUM;
+    if (x <= F16(-11.7835)) return 0;
+
+    if (x < 0) {
+        x = -x;
+        exp_values = exp_neg_values;
+    } else {
+        exp_values = exp_pos_values;
+    }
+
+    res = FIX16_ONE;
+    arg = FIX16_ONE;
+    for (i = 0; i < NUM_EXP_VALUES; i++) {
+        while (x >= arg) {
+            res = fix16_mul(res, exp_values[i]);
+            x -= arg;
+        }
+        arg >>= 3;
+    }
+    return res;
+}
+
+/*******************************************************************
+ *  VOC ALGORITHM
+ *******************************************************************/
+
+/**
+ * @brief constructor and initialize variables
+ */
+SVM40_VocAlgorithm::SVM40_VocAlgorithm(void) {
+    Init();
+}
+
+/**
+ * @brief : reset the algorithm with default tuning parameters
+ */
+void SVM40_VocAlgorithm::Init() {
+
+    _Voc_Index_Offset = F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT);
+    _Tau_Mean_Variance_Hours = F16(VocAlgorithm_TAU_MEAN_VARIANCE_HOURS);
+    _Gating_Max_Duration_Minutes = F16(VocAlgorithm_GATING_MAX_DURATION_MINUTES);
+    _Sraw_Std_Initial = F16(VocAlgorithm_SRAW_STD_INITIAL);
+    _Uptime = F16(0.);
+    _Sraw = F16(0.);
+    _Voc_Index = 0;
+    InitInstances();
+}
+
+/**
+ * @brief : (re)start the sub-parts with the current parameters
+ */
+void SVM40_VocAlgorithm::InitInstances() {
+
+    MveInit();
+    MveSetParameters(_Sraw_Std_Initial, _Tau_Mean_Variance_Hours, _Gating_Max_Duration_Minutes);
+    MoxSetParameters(MveGetStd(), MveGetMean());
+    SigmoidScaledSetParameters(_Voc_Index_Offset);
+    LowpassSetParameters();
+}
+
+/**
+ * @brief : get the algorithm state
+ */
+void SVM40_VocAlgorithm::GetStates(int32_t *state0, int32_t *state1) {
+    *state0 = MveGetMean();
+    *state1 = MveGetStd();
+}
+
+/**
+ * @brief : set the algorithm state
+ */
+void SVM40_VocAlgorithm::SetStates(int32_t state0, int32_t state1) {
+    MveSetStates(state0, state1, F16(VocAlgorithm_PERSISTENCE_UPTIME_GAMMA));
+    _Sraw = state0;
+}
+
+/**
+ * @brief : set the tuning parameters
+ */
+void SVM40_VocAlgorithm::SetTuningParameters(int16_t voc_index_offset, int16_t learning_time_hours,
+                                             int16_t gating_max_duration_minutes, int16_t std_initial) {
+    _Voc_Index_Offset = fix16_from_int(voc_index_offset);
+    _Tau_Mean_Variance_Hours = fix16_from_int(learning_time_hours);
+    _Gating_Max_Duration_Minutes = fix16_from_int(gating_max_duration_minutes);
+    _Sraw_Std_Initial = fix16_from_int(std_initial);
+    InitInstances();
+}
+
+/**
+ * @brief : process a raw VOC sample
+ * @param sraw : raw VOC ticks
+ *
+ * @return : VOC index
+ */
+int32_t SVM40_VocAlgorithm::Process(int32_t sraw) {
+
+    if (_Uptime <= F16(VocAlgorithm_INITIAL_BLACKOUT)) {
+        _Uptime = _Uptime + F16(VocAlgorithm_SAMPLING_INTERVAL);
+    }
+    else {
+        if (sraw > 0 && sraw < 65000) {
+            if (sraw < 20001) sraw = 20001;
+            else if (sraw > 52767) sraw = 52767;
+
+            _Sraw = fix16_from_int(sraw - 20000);
+        }
+
+        _Voc_Index = MoxProcess(_Sraw);
+        _Voc_Index = SigmoidScaledProcess(_Voc_Index);
+        _Voc_Index = LowpassProcess(_Voc_Index);
+
+        if (_Voc_Index < F16(0.5)) _Voc_Index = F16(0.5);
+
+        if (_Sraw > F16(0.)) {
+            MveProcess(_Sraw, _Voc_Index);
+            MoxSetParameters(MveGetStd(), MveGetMean());
+        }
+    }
+
+    return(fix16_cast_to_int(_Voc_Index + F16(0.5)));
+}
+
+/**
+ * @brief : mean variance estimator
+ */
+void SVM40_VocAlgorithm::MveInit() {
+    MveSetParameters(F16(0.), F16(0.), F16(0.));
+}
+
+void SVM40_VocAlgorithm::MveSetParameters(fix16_t std_initial, fix16_t tau_mean_variance_hours,
+                                          fix16_t gating_max_duration_minutes) {
+
+    _Mve_Gating_Max_Duration_Minutes = gating_max_duration_minutes;
+    _Mve_Initialized = false;
+    _Mve_Mean = F16(0.);
+    _Mve_Sraw_Offset = F16(0.);
+    _Mve_Std = std_initial;
+    _Mve_Gamma = fix16_div(F16((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING *
+                                (VocAlgorithm_SAMPLING_INTERVAL / 3600.))),
+                           (tau_mean_variance_hours + F16((VocAlgorithm_SAMPLING_INTERVAL / 3600.))));
+    _Mve_Gamma_Initial_Mean = F16(((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING * VocAlgorithm_SAMPLING_INTERVAL) /
+                                   (VocAlgorithm_TAU_INITIAL_MEAN + VocAlgorithm_SAMPLING_INTERVAL)));
+    _Mve_Gamma_Initial_Variance = F16(((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING * VocAlgorithm_SAMPLING_INTERVAL) /
+                                       (VocAlgorithm_TAU_INITIAL_VARIANCE + VocAlgorithm_SAMPLING_INTERVAL)));
+    _Mve_Gamma_Mean = F16(0.);
+    _Mve_Gamma_Variance = F16(0.);
+    _Mve_Uptime_Gamma = F16(0.);
+    _Mve_Uptime_Gating = F16(0.);
+    _Mve_Gating_Duration_Minutes = F16(0.);
+}
+
+void SVM40_VocAlgorithm::MveSetStates(fix16_t mean, fix16_t std, fix16_t uptime_gamma) {
+    _Mve_Mean = mean;
+    _Mve_Std = std;
+    _Mve_Uptime_Gamma = uptime_gamma;
+    _Mve_Initialized = true;
+}
+
+fix16_t SVM40_VocAlgorithm::MveGetStd() {
+    return(_Mve_Std);
+}
+
+fix16_t SVM40_VocAlgorithm::MveGetMean() {
+    return(_Mve_Mean + _Mve_Sraw_Offset);
+}
+
+void SVM40_VocAlgorithm::MveCalculateGamma(fix16_t voc_index_from_prior) {
+    fix16_t uptime_limit;
+    fix16_t sigmoid_gamma_mean;
+    fix16_t gamma_mean;
+    fix16_t gating_threshold_mean;
+    fix16_t sigmoid_gating_mean;
+    fix16_t sigmoid_gamma_variance;
+    fix16_t gamma_variance;
+    fix16_t gating_threshold_variance;
+    fix16_t sigmoid_gating_variance;
+
+    uptime_limit = F16((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__FIX16_MAX - VocAlgorithm_SAMPLING_INTERVAL));
+
+    if (_Mve_Uptime_Gamma < uptime_limit)
+        _Mve_Uptime_Gamma = _Mve_Uptime_Gamma + F16(VocAlgorithm_SAMPLING_INTERVAL);
+
+    if (_Mve_Uptime_Gating < uptime_limit)
+        _Mve_Uptime_Gating = _Mve_Uptime_Gating + F16(VocAlgorithm_SAMPLING_INTERVAL);
+
+    MveSigmoidSetParameters(F16(1.), F16(VocAlgorithm_INIT_DURATION_MEAN), F16(VocAlgorithm_INIT_TRANSITION_MEAN));
+    sigmoid_gamma_mean = MveSigmoidProcess(_Mve_Uptime_Gamma);
+    gamma_mean = _Mve_Gamma + fix16_mul(_Mve_Gamma_Initial_Mean - _Mve_Gamma, sigmoid_gamma_mean);
+
+    gating_threshold_mean = F16(VocAlgorithm_GATING_THRESHOLD) +
+                            fix16_mul(F16((VocAlgorithm_GATING_THRESHOLD_INITIAL - VocAlgorithm_GATING_THRESHOLD)),
+                                      MveSigmoidProcess(_Mve_Uptime_Gating));
+
+    MveSigmoidSetParameters(F16(1.), gating_threshold_mean, F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION));
+    sigmoid_gating_mean = MveSigmoidProcess(voc_index_from_prior);
+    _Mve_Gamma_Mean = fix16_mul(sigmoid_gating_mean, gamma_mean);
+
+    MveSigmoidSetParameters(F16(1.), F16(VocAlgorithm_INIT_DURATION_VARIANCE), F16(VocAlgorithm_INIT_TRANSITION_VARIANCE));
+    sigmoid_gamma_variance = MveSigmoidProcess(_Mve_Uptime_Gamma);
+    gamma_variance = _Mve_Gamma + fix16_mul(_Mve_Gamma_Initial_Variance - _Mve_Gamma,
+                                            sigmoid_gamma_variance - sigmoid_gamma_mean);
+
+    gating_threshold_variance = F16(VocAlgorithm_GATING_THRESHOLD) +
+                                fix16_mul(F16((VocAlgorithm_GATING_THRESHOLD_INITIAL - VocAlgorithm_GATING_THRESHOLD)),
+                                          MveSigmoidProcess(_Mve_Uptime_Gating));
+
+    MveSigmoidSetParameters(F16(1.), gating_threshold_variance, F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION));
+    sigmoid_gating_variance = MveSigmoidProcess(voc_index_from_prior);
+    _Mve_Gamma_Variance = fix16_mul(sigmoid_gating_variance, gamma_variance);
+
+    _Mve_Gating_Duration_Minutes = _Mve_Gating_Duration_Minutes +
+        fix16_mul(F16((VocAlgorithm_SAMPLING_INTERVAL / 60.)),
+                  fix16_mul(F16(1.) - sigmoid_gating_mean, F16((1. + VocAlgorithm_GATING_MAX_RATIO))) -
+                  F16(VocAlgorithm_GATING_MAX_RATIO));
+
+    if (_Mve_Gating_Duration_Minutes < F16(0.))
+        _Mve_Gating_Duration_Minutes = F16(0.);
+
+    if (_Mve_Gating_Duration_Minutes > _Mve_Gating_Max_Duration_Minutes)
+        _Mve_Uptime_Gating = F16(0.);
+}
+
+void SVM40_VocAlgorithm::MveProcess(fix16_t sraw, fix16_t voc_index_from_prior) {
+    fix16_t delta_sgp;
+    fix16_t c;
+    fix16_t additional_scaling;
+
+    if (! _Mve_Initialized) {
+        _Mve_Initialized = true;
+        _Mve_Sraw_Offset = sraw;
+        _Mve_Mean = F16(0.);
+        return;
+    }
+
+    if (_Mve_Mean >= F16(100.) || _Mve_Mean <= F16(-100.)) {
+        _Mve_Sraw_Offset = _Mve_Sraw_Offset + _Mve_Mean;
+        _Mve_Mean = F16(0.);
+    }
+
+    sraw = sraw - _Mve_Sraw_Offset;
+    MveCalculateGamma(voc_index_from_prior);
+    delta_sgp = fix16_div(sraw - _Mve_Mean, F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING));
+
+    if (delta_sgp < F16(0.)) c = _Mve_Std - delta_sgp;
+    else c = _Mve_Std + delta_sgp;
+
+    additional_scaling = F16(1.);
+    if (c > F16(1440.)) additional_scaling = F16(4.);
+
+    _Mve_Std = fix16_mul(
+        fix16_sqrt(fix16_mul(additional_scaling,
+                             F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING) - _Mve_Gamma_Variance)),
+        fix16_sqrt(fix16_mul(_Mve_Std,
+                             fix16_div(_Mve_Std,
+                                       fix16_mul(F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING),
+                                                 additional_scaling))) +
+                   fix16_mul(fix16_div(fix16_mul(_Mve_Gamma_Variance, delta_sgp), additional_scaling),
+                             delta_sgp)));
+
+    _Mve_Mean = _Mve_Mean + fix16_mul(_Mve_Gamma_Mean, delta_sgp);
+}
+
+void SVM40_VocAlgorithm::MveSigmoidSetParameters(fix16_t L, fix16_t X0, fix16_t K) {
+    _Mve_Sigmoid_L = L;
+    _Mve_Sigmoid_K = K;
+    _Mve_Sigmoid_X0 = X0;
+}
+
+fix16_t SVM40_VocAlgorithm::MveSigmoidProcess(fix16_t sample) {
+    fix16_t x;
+
+    x = fix16_mul(_Mve_Sigmoid_K, sample - _Mve_Sigmoid_X0);
+
+    if (x < F16(-50.)) return(_Mve_Sigmoid_L);
+    else if (x > F16(50.)) return(F16(0.));
+
+    return(fix16_div(_Mve_Sigmoid_L, F16(1.) + fix16_exp(x)));
+}
+
+/**
+ * @brief : mox model
+ */
+void SVM40_VocAlgorithm::MoxSetParameters(fix16_t SRAW_STD, fix16_t SRAW_MEAN) {
+    _Mox_Sraw_Std = SRAW_STD;
+    _Mox_Sraw_Mean = SRAW_MEAN;
+}
+
+fix16_t SVM40_VocAlgorithm::MoxProcess(fix16_t sraw) {
+    return(fix16_mul(fix16_div(sraw - _Mox_Sraw_Mean, -(_Mox_Sraw_Std + F16(VocAlgorithm_SRAW_STD_BONUS))),
+                     F16(VocAlgorithm_VOC_INDEX_GAIN)));
+}
+
+/**
+ * @brief : sigmoid scaled
+ */
+void SVM40_VocAlgorithm::SigmoidScaledSetParameters(fix16_t offset) {
+    _Sigmoid_Offset = offset;
+}
+
+fix16_t SVM40_VocAlgorithm::SigmoidScaledProcess(fix16_t sample) {
+    fix16_t x;
+    fix16_t shift;
+
+    x = fix16_mul(F16(VocAlgorithm_SIGMOID_K), sample - F16(VocAlgorithm_SIGMOID_X0));
+
+    if (x < F16(-50.)) return(F16(VocAlgorithm_SIGMOID_L));
+    else if (x > F16(50.)) return(F16(0.));
+
+    if (sample >= F16(0.)) {
+        shift = fix16_div(F16(VocAlgorithm_SIGMOID_L) - fix16_mul(F16(5.), _Sigmoid_Offset), F16(4.));
+        return(fix16_div(F16(VocAlgorithm_SIGMOID_L) + shift, F16(1.) + fix16_exp(x)) - shift);
+    }
+
+    return(fix16_mul(fix16_div(_Sigmoid_Offset, F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT)),
+                     fix16_div(F16(VocAlgorithm_SIGMOID_L), F16(1.) + fix16_exp(x))));
+}
+
+/**
+ * @brief : adaptive lowpass
+ */
+void SVM40_VocAlgorithm::LowpassSetParameters() {
+    _Lp_A1 = F16((VocAlgorithm_SAMPLING_INTERVAL / (VocAlgorithm_LP_TAU_FAST + VocAlgorithm_SAMPLING_INTERVAL)));
+    _Lp_A2 = F16((VocAlgorithm_SAMPLING_INTERVAL / (VocAlgorithm_LP_TAU_SLOW + VocAlgorithm_SAMPLING_INTERVAL)));
+    _Lp_Initialized = false;
+}
+
+fix16_t SVM40_VocAlgorithm::LowpassProcess(fix16_t sample) {
+    fix16_t abs_delta;
+    fix16_t F1;
+    fix16_t tau_a;
+    fix16_t a3;
+
+    if (! _Lp_Initialized) {
+        _Lp_X1 = sample;
+        _Lp_X2 = sample;
+        _Lp_X3 = sample;
+        _Lp_Initialized = true;
+    }
+
+    _Lp_X1 = fix16_mul(F16(1.) - _Lp_A1, _Lp_X1) + fix16_mul(_Lp_A1, sample);
+    _Lp_X2 = fix16_mul(F16(1.) - _Lp_A2, _Lp_X2) + fix16_mul(_Lp_A2, sample);
+
+    abs_delta = _Lp_X1 - _Lp_X2;
+    if (abs_delta < F16(0.)) abs_delta = -abs_delta;
+
+    F1 = fix16_exp(fix16_mul(F16(VocAlgorithm_LP_ALPHA), abs_delta));
+    tau_a = fix16_mul(F16((VocAlgorithm_LP_TAU_SLOW - VocAlgorithm_LP_TAU_FAST)), F1) + F16(VocAlgorithm_LP_TAU_FAST);
+    a3 = fix16_div(F16(VocAlgorithm_SAMPLING_INTERVAL), F16(VocAlgorithm_SAMPLING_INTERVAL) + tau_a);
+    _Lp_X3 = fix16_mul(F16(1.) - a3, _Lp_X3) + fix16_mul(a3, sample);
+
+    return(_Lp_X3);
+}
@@ -0,0 +1,167 @@
+/**
+ * SVM40 Library VOC index algorithm
+ *
+ * Copyright (c) October 2026, Paul van Haastrecht
+ *
+ * Based on the Sensirion VOC index algorithm (sensirion_voc_algorithm.c)
+ * Copyright (c) 2021, Sensirion AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of Sensirion AG nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************
+ * Version 1.0 / October 2026 / paulvha
+ * - Initial version
+ *
+ * The VOC index algorithm as running in the SVM40, to calculate the VOC
+ * index from the raw VOC ticks (raw_voc_ticks in svm40_values). It uses
+ * 16.16 fixed point only, so the result is the same on every platform.
+ *
+ * This allows to reprocess recorded raw ticks with other tuning
+ * parameters (svm_algopar) than the sensor used.
+ *
+ * The algorithm expects a sample every second. It does NOT depend on
+ * Arduino and can be compiled on a host as well :
+ *
+ *   g++ -O2 -c svm40_voc_algorithm.cpp
+ *********************************************************************
+ */
+#ifndef SVM40_VOC_ALGORITHM_H
+#define SVM40_VOC_ALGORITHM_H
+
+#include <stdint.h>
+
+typedef int32_t fix16_t;
+
+class SVM40_VocAlgorithm
+{
+  public:
+
+    SVM40_VocAlgorithm(void);
+
+    /**
+     * @brief : reset the algorithm (start of learning phase)
+     *
+     * The tuning parameters are set to default.
+     */
+    void Init();
+
+    /**
+     * @brief : set the tuning parameters (same as svm_algopar)
+     * @param voc_index_offset            : default 100
+     * @param learning_time_hours         : default 12
+     * @param gating_max_duration_minutes : default 180
+     * @param std_initial                 : default 50
+     *
+     * This will restart the learning phase.
+     */
+    void SetTuningParameters(int16_t voc_index_offset, int16_t learning_time_hours,
+                             int16_t gating_max_duration_minutes, int16_t std_initial);
+
+    /**
+     * @brief : process a raw VOC sample (once per second)
+     * @param sraw : raw VOC ticks
+     *
+     * @return : VOC index (1 - 500, zero during the first 45 samples)
+     */
+    int32_t Process(int32_t sraw);
+
+    /**
+     * @brief : get / set the algorithm state (mean and std estimate)
+     *
+     * Can be used to continue after a short interruption.
+     */
+    void GetStates(int32_t *state0, int32_t *state1);
+    void SetStates(int32_t state0, int32_t state1);
+
+  private:
+
+    void    InitInstances();
+
+    // mean variance estimator
+    void    MveInit();
+    void    MveSetParameters(fix16_t std_initial, fix16_t tau_mean_variance_hours,
+                             fix16_t gating_max_duration_minutes);
+    void    MveSetStates(fix16_t mean, fix16_t std, fix16_t uptime_gamma);
+    fix16_t MveGetStd();
+    fix16_t MveGetMean();
+    void    MveCalculateGamma(fix16_t voc_index_from_prior);
+    void    MveProcess(fix16_t sraw, fix16_t voc_index_from_prior);
+    void    MveSigmoidSetParameters(fix16_t L, fix16_t X0, fix16_t K);
+    fix16_t MveSigmoidProcess(fix16_t sample);
+
+    // mox model, sigmoid and low pass
+    void    MoxSetParameters(fix16_t SRAW_STD, fix16_t SRAW_MEAN);
+    fix16_t MoxProcess(fix16_t sraw);
+    void    SigmoidScaledSetParameters(fix16_t offset);
+    fix16_t SigmoidScaledProcess(fix16_t sample);
+    void    LowpassSetParameters();
+    fix16_t LowpassProcess(fix16_t sample);
+
+    // parameters
+    fix16_t _Voc_Index_Offset;
+    fix16_t _Tau_Mean_Variance_Hours;
+    fix16_t _Gating_Max_Duration_Minutes;
+    fix16_t _Sraw_Std_Initial;
+    fix16_t _Uptime;
+    fix16_t _Sraw;
+    fix16_t _Voc_Index;
+
+    // mean variance estimator
+    fix16_t _Mve_Gating_Max_Duration_Minutes;
+    bool    _Mve_Initialized;
+    fix16_t _Mve_Mean;
+    fix16_t _Mve_Sraw_Offset;
+    fix16_t _Mve_Std;
+    fix16_t _Mve_Gamma;
+    fix16_t _Mve_Gamma_Initial_Mean;
+    fix16_t _Mve_Gamma_Initial_Variance;
+    fix16_t _Mve_Gamma_Mean;
+    fix16_t _Mve_Gamma_Variance;
+    fix16_t _Mve_Uptime_Gamma;
+    fix16_t _Mve_Uptime_Gating;
+    fix16_t _Mve_Gating_Duration_Minutes;
+    fix16_t _Mve_Sigmoid_L;
+    fix16_t _Mve_Sigmoid_K;
+    fix16_t _Mve_Sigmoid_X0;
+
+    // mox model
+    fix16_t _Mox_Sraw_Std;
+    fix16_t _Mox_Sraw_Mean;
+
+    // sigmoid scaled
+    fix16_t _Sigmoid_Offset;
+
+    // adaptive lowpass
+    fix16_t _Lp_A1;
+    fix16_t _Lp_A2;
+    bool    _Lp_Initialized;
+    fix16_t _Lp_X1;
+    fix16_t _Lp_X2;
+    fix16_t _Lp_X3;
+};
+
+#endif /* SVM40_VOC_ALGORITHM_H */